@@ -1,5 +1,6 @@
 #pragma once
 #include <qdpeg/err_code.hpp>
+#include <qdpeg/literal_trie.hpp>
 #include <qdpeg/whitespace.hpp>
 #include <qdpeg/qdbase.hpp>
 #include <optional>
@@ -9,6 +10,7 @@ namespace qdpeg
     template<class P>
     constexpr auto opt(P p)
     {
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
         using opt_res = std::conditional_t<is_skipper<P>(),
             Nothing,
             std::optional<Parsed_type<P>>>;
@@ -19,6 +21,8 @@ namespace qdpeg
             auto parsed = p(b,e);
             if (parsed)
                 return { parsed.iter,opt_res { std::move(parsed.value())}};
+            if (parsed.committed)
+                return { parsed.iter, parsed.error() };
             return { b, opt_res {} };
         };
     }
@@ -27,8 +31,9 @@ namespace qdpeg
     constexpr auto check(P p,BF f)
     {
         static_assert(is_parser<P>(),"Parser accepted");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
 
-        return [p,f](Iter b,Iter e) mutable -> Parsed_return<P>
+        return [p,f](Iter b,Iter e) -> Parsed_return<P>
         {
             auto res = p(b,e);
             if (res)
@@ -46,8 +51,9 @@ namespace qdpeg
     constexpr auto and_p(MustP must,P p)
     {
         static_assert(is_parser<MustP>() && is_parser<P>(),"Only parsers accepted");
+        static_assert(is_const_parser<MustP>() && is_const_parser<P>(),"Parsers must be callable as const");
 
-        return [must,p](Iter b,Iter e) mutable -> Parsed_return<P>
+        return [must,p](Iter b,Iter e) -> Parsed_return<P>
         {
             auto temp = must(b,e);
             if (temp)
@@ -67,8 +73,9 @@ namespace qdpeg
     constexpr auto not_p(NonP nonp, P p)
     {
         static_assert(is_parser<NonP>() && is_parser<P>(),"Only parsers accepted");
+        static_assert(is_const_parser<NonP>() && is_const_parser<P>(),"Parsers must be callable as const");
 
-        return [nonp,p](Iter b,Iter e) mutable -> Parsed_return<P>
+        return [nonp,p](Iter b,Iter e) -> Parsed_return<P>
         {
             auto temp = nonp(b,e);
             if (temp)
@@ -85,16 +92,45 @@ namespace qdpeg
         return not_p(ps,empty);
     }
 
+    //  Once p is entered, a failure of p fails the enclosing choice
+    //  instead of trying its remaining alternatives.
+    template<class P>
+    constexpr auto commit(P p)
+    {
+        static_assert(is_parser<P>(),"Only parsers accepted");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+
+        return [p](Iter b,Iter e) -> Parsed_return<P>
+        {
+            auto res = p(b,e);
+            if (!res)
+                res.committed = true;
+            return res;
+        };
+    }
+
     //  Always emit a T with value t
     template<class T>
     constexpr auto emit(T t)
     {
+        static_assert(std::is_copy_constructible_v<T>,"emit copies its value. Use emit_with for move-only types");
         return [t](Iter b,Iter ) -> Parse_result<T>
         {
             return { b , t };
         };
     }
 
+    //  Always emit the value made by f(), e.g. a new node of a move-only type
+    template<class F>
+    constexpr auto emit_with(F f)
+    {
+        using T = std::invoke_result_t<F const&>;
+        return [f](Iter b,Iter ) -> Parse_result<T>
+        {
+            return { b , f() };
+        };
+    }
+
     template<class P>
     constexpr auto when(bool allow,P ps)
     {
@@ -122,52 +158,78 @@ namespace qdpeg
     template<class P>
     constexpr auto raw(P ps)
     {
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
         return [ps](Iter b,Iter e) -> Parse_result<Raw>
         {
             auto res = skip(ps)(b,e);
             if (res)
                 return { res.iter, make_raw(b,res.iter) };
-            return { res.iter, res.error() };
+            return { res.iter, res.error(), res.committed };
         };
     }
 
+    namespace details
+    {
+        //  A skipper giving a fixed value, a named type so that a choice
+        //  of literals with values can be recognised
+        template<class P,class T>
+        struct As_value
+        {
+            P ps;
+            T t;
+
+            constexpr auto operator()(Iter b,Iter e) const -> Parse_result<T>
+            {
+                auto res = ps(b,e);
+                if (res)
+                    return { res.iter, t };
+                return { res.iter, res.error(), res.committed };
+            }
+        };
+
+        template<class P,class T>
+        struct literal_traits<As_value<P,T>>
+        {
+            static constexpr bool is_literal = literal_traits<P>::is_literal;
+            static constexpr bool case_insensitive = literal_traits<P>::case_insensitive;
+            static std::string_view key(As_value<P,T> const& p) { return literal_traits<P>::key(p.ps); }
+            static T const& value(As_value<P,T> const& p) { return p.t; }
+        };
+    }   //  namespace details
+
     template<class T,class P>
     constexpr auto as(P ps)
     {
-        return [ps](Iter b,Iter e) mutable -> Parse_result<T>
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+        return [ps](Iter b,Iter e) -> Parse_result<T>
         {
             auto res = ps(b,e);
             if (res)
                 return { res.iter, static_cast<T>(std::move(res.value())) };
-            return { res.iter, res.error() };
+            return { res.iter, res.error(), res.committed };
         };
     }
 
     template<class P,class T>
     constexpr auto as(P ps,T t)
     {
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
         using org_return = Parsed_type<P>;
         if constexpr (std::is_invocable_v<T,org_return>)
         {
             using ret_type = std::invoke_result_t<T,org_return>;
-            return [ps,t](Iter b,Iter e) mutable -> Parse_result<ret_type>
+            return [ps,t](Iter b,Iter e) -> Parse_result<ret_type>
             {
                 auto res = ps(b,e);
                 if (res)
-                    return { res.iter, t(res.value()) };
-                return { res.iter, res.error() };
+                    return { res.iter, t(std::move(res.value())) };
+                return { res.iter, res.error(), res.committed };
             };
         }
         else
         {
             static_assert(is_skipper<P>(),"Converting to value should be from white space");
-            return [ps,t](Iter b,Iter e) mutable -> Parse_result<T>
-            {
-                auto res = ps(b,e);
-                if (res)
-                    return { res.iter, t };
-                return { res.iter, res.error() };
-            };
+            return details::As_value<P,T> { ps, t };
         }
     }
 }   //  qdpeg
@@ -0,0 +1,204 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <array>
+#include <cstdint>
+#include <limits>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace qdpeg
+{
+    //  A set of characters represented as a 256-bit bitmap. Classes can be
+    //  combined with set operations and are themselves char parsers.
+    class Char_class
+    {
+    public:
+        constexpr Char_class() = default;
+
+        constexpr bool contains(char ch) const noexcept
+        {
+            auto u = static_cast<unsigned char>(ch);
+            return (bits[u >> 6] >> (u & 63)) & 1;
+        }
+
+        constexpr Char_class& add(char ch) noexcept
+        {
+            auto u = static_cast<unsigned char>(ch);
+            bits[u >> 6] |= std::uint64_t(1) << (u & 63);
+            return *this;
+        }
+
+        constexpr Char_class& add(char lo,char hi) noexcept
+        {
+            for (int u = static_cast<unsigned char>(lo); u <= static_cast<unsigned char>(hi); ++u)
+                add(static_cast<char>(u));
+            return *this;
+        }
+
+        auto operator()(Iter b,Iter e) const -> Parse_result<char>
+        {
+            if (b == e)
+                return { b, Error_code::unexpected_eof };
+            char ch = *b;
+            if (!contains(ch))
+                return { b, Error_code::unexpected_char };
+            return { ++b, ch };
+        }
+
+        friend constexpr Char_class operator|(Char_class lhs,Char_class const& rhs) noexcept
+        {
+            for (int i = 0; i < 4; ++i) lhs.bits[i] |= rhs.bits[i];
+            return lhs;
+        }
+        friend constexpr Char_class operator&(Char_class lhs,Char_class const& rhs) noexcept
+        {
+            for (int i = 0; i < 4; ++i) lhs.bits[i] &= rhs.bits[i];
+            return lhs;
+        }
+        //  Characters in lhs that are not in rhs
+        friend constexpr Char_class operator-(Char_class lhs,Char_class const& rhs) noexcept
+        {
+            for (int i = 0; i < 4; ++i) lhs.bits[i] &= ~rhs.bits[i];
+            return lhs;
+        }
+        friend constexpr Char_class operator~(Char_class cls) noexcept
+        {
+            for (int i = 0; i < 4; ++i) cls.bits[i] = ~cls.bits[i];
+            return cls;
+        }
+        friend constexpr bool operator==(Char_class const& lhs,Char_class const& rhs) noexcept
+        {
+            return lhs.bits[0] == rhs.bits[0] && lhs.bits[1] == rhs.bits[1]
+                && lhs.bits[2] == rhs.bits[2] && lhs.bits[3] == rhs.bits[3];
+        }
+        friend constexpr bool operator!=(Char_class const& lhs,Char_class const& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    private:
+        std::uint64_t bits[4] {};
+    };
+
+    template<char... Chars>
+    inline constexpr Char_class char_class_of = []
+    {
+        Char_class cls;
+        (cls.add(Chars),...);
+        return cls;
+    }();
+
+    constexpr Char_class char_class_range(char lo,char hi) noexcept
+    {
+        return Char_class {}.add(lo,hi);
+    }
+
+    //  The class of characters for which f holds
+    template<class F>
+    constexpr Char_class char_class_if(F f)
+    {
+        Char_class cls;
+        for (int u = 0; u < 256; ++u)
+            if (f(static_cast<char>(u)))
+                cls.add(static_cast<char>(u));
+        return cls;
+    }
+
+    namespace char_classes
+    {
+        inline constexpr Char_class digit  = char_class_range('0','9');
+        inline constexpr Char_class lower  = char_class_range('a','z');
+        inline constexpr Char_class upper  = char_class_range('A','Z');
+        inline constexpr Char_class alpha  = lower | upper;
+        inline constexpr Char_class alnum  = alpha | digit;
+        inline constexpr Char_class xdigit = digit | char_class_range('a','f') | char_class_range('A','F');
+        inline constexpr Char_class lspace = char_class_of<' ','\t'>;
+        inline constexpr Char_class space  = char_class_of<' ','\t','\n','\r','\f','\v'>;
+        inline constexpr Char_class print  = char_class_range(' ','~');
+        inline constexpr Char_class ident  = alnum | char_class_of<'_'>;
+    }   //  namespace char_classes
+}   //  qdpeg
+
+namespace qdpeg::details
+{
+    //  Finds the end of a run of characters belonging to a class.
+    //  With SSSE3, 16 characters are classified at a time: the low nibble
+    //  of each character selects a byte of bits for the possible high
+    //  nibbles, and the high nibble selects the bit.
+    class Class_scanner
+    {
+    public:
+        explicit constexpr Class_scanner(Char_class const& c)
+            : cls(c)
+        {
+            for (int u = 0; u < 256; ++u)
+            {
+                if (cls.contains(static_cast<char>(u)))
+                {
+                    auto& row = u < 128 ? low_rows : high_rows;
+                    row[u & 15] |= static_cast<std::uint8_t>(1 << ((u >> 4) & 7));
+                }
+            }
+        }
+
+        //  First position in [b,e) not in the class
+        Iter skip_in(Iter b,Iter e) const noexcept
+        {
+#if defined(__SSSE3__)
+            if (e - b >= 16)
+            {
+                char const* first = &*b;
+                char const* p = first;
+                char const* last = first + (e - b);
+                __m128i const lo_tab = _mm_loadu_si128(reinterpret_cast<__m128i const*>(low_rows.data()));
+                __m128i const hi_tab = _mm_loadu_si128(reinterpret_cast<__m128i const*>(high_rows.data()));
+                __m128i const bit_tab = _mm_setr_epi8(1,2,4,8,16,32,64,-128,1,2,4,8,16,32,64,-128);
+                __m128i const nibble = _mm_set1_epi8(0x0f);
+                __m128i const seven = _mm_set1_epi8(7);
+                for (; last - p >= 16; p += 16)
+                {
+                    __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+                    __m128i lo = _mm_and_si128(v,nibble);
+                    __m128i hi = _mm_and_si128(_mm_srli_epi16(v,4),nibble);
+                    __m128i upper = _mm_cmpgt_epi8(hi,seven);
+                    __m128i rows = _mm_or_si128(
+                        _mm_andnot_si128(upper,_mm_shuffle_epi8(lo_tab,lo)),
+                        _mm_and_si128(upper,_mm_shuffle_epi8(hi_tab,lo)));
+                    __m128i hit = _mm_and_si128(rows,_mm_shuffle_epi8(bit_tab,hi));
+                    unsigned miss = static_cast<unsigned>(
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(hit,_mm_setzero_si128())));
+                    if (miss)
+                        return b + ((p - first) + __builtin_ctz(miss));
+                }
+                b += p - first;
+            }
+#endif
+            while (b != e && cls.contains(*b))
+                ++b;
+            return b;
+        }
+
+    private:
+        Char_class cls;
+        std::array<std::uint8_t,16> low_rows {};
+        std::array<std::uint8_t,16> high_rows {};
+    };
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    //  Parse a run of min_n to max_n characters from cls as Raw
+    inline auto span_of(Char_class const& cls,
+        int min_n = 0,
+        int max_n = std::numeric_limits<int>::max())
+    {
+        return [scanner = details::Class_scanner(cls),min_n,max_n](Iter b,Iter e)
+            -> Parse_result<Raw>
+        {
+            Iter end = scanner.skip_in(b,take(b,e,max_n));
+            if (end - b < min_n)
+                return { end, Error_code::to_few };
+            return { end, make_raw(b,end) };
+        };
+    }
+}   //  qdpeg
@@ -1,13 +1,19 @@
 #pragma once
+#include <qdpeg/literal_trie.hpp>
 #include <qdpeg/qdbase.hpp>
 #include <boost/mp11.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <tuple>
 #include <variant>
 
 namespace qdpeg::details
 {
     template <size_t I,class Result,class ParseTup>
-    constexpr auto build_result(Iter b,Iter e,ParseTup& ptup) 
+    constexpr auto build_result(Iter b,Iter e,ParseTup const& ptup) 
         -> Parse_result<Result> 
     {
         using Parser = std::tuple_element_t<I, ParseTup>;
@@ -35,6 +41,9 @@ namespace qdpeg::details
             }
             else
             {
+                //  A committed alternative fails the choice
+                if (this_res.committed)
+                    return { this_res.iter, this_res.error() };
                 auto alt_res = build_result<I + 1,Result>(b,e,ptup);
                 if (alt_res || alt_res.iter > this_res.iter) 
                     return alt_res;
@@ -42,6 +51,67 @@ namespace qdpeg::details
             }
         }
     };
+
+    //  The hits of the alternatives of an adaptive_choice and the order to
+    //  try them in, four bits per alternative. Shared by copies of the
+    //  parser. The counts are statistics, so they are incremented without
+    //  read-modify-write instructions and may lose concurrent updates.
+    template<std::size_t N>
+    struct Choice_stats
+    {
+        static_assert(N <= 16,"adaptive_choice supports at most 16 alternatives");
+
+        //  Successful parses between reorderings
+        static constexpr std::uint32_t period = 1024;
+
+        Choice_stats()
+        {
+            std::uint64_t o = 0;
+            for (std::size_t i = 0; i < N; ++i)
+                o |= std::uint64_t(i) << (4 * i);
+            order.store(o,std::memory_order_relaxed);
+        }
+
+        void hit(std::size_t i)
+        {
+            bump(hits[i]);
+            if (bump(calls) % period == 0)
+                reorder();
+        }
+
+        static std::uint32_t bump(std::atomic<std::uint32_t>& n)
+        {
+            std::uint32_t const v = n.load(std::memory_order_relaxed) + 1;
+            n.store(v,std::memory_order_relaxed);
+            return v;
+        }
+
+        //  Most hits first. The counts are halved, so the order follows
+        //  changes in the input.
+        void reorder()
+        {
+            std::array<std::uint32_t,N> counts;
+            std::array<std::uint8_t,N> idx;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                counts[i] = hits[i].load(std::memory_order_relaxed);
+                hits[i].store(counts[i] / 2,std::memory_order_relaxed);
+                idx[i] = static_cast<std::uint8_t>(i);
+            }
+            std::stable_sort(idx.begin(),idx.end(),[&counts](auto a,auto b)
+            {
+                return counts[a] > counts[b];
+            });
+            std::uint64_t o = 0;
+            for (std::size_t k = 0; k < N; ++k)
+                o |= std::uint64_t(idx[k]) << (4 * k);
+            order.store(o,std::memory_order_relaxed);
+        }
+
+        std::atomic<std::uint64_t>                  order;
+        std::atomic<std::uint32_t>                  calls { 0 };
+        std::array<std::atomic<std::uint32_t>,N>    hits {};
+    };
 }   //  namespace qdpeg::details
 
 namespace qdpeg
@@ -57,11 +127,38 @@ namespace qdpeg
         using no_skippers = boost::mp11::mp_none_of<my_types,is_skipper_t>;
         using all_skippers = boost::mp11::mp_all_of<my_types,is_skipper_t>;
         static_assert(no_skippers() || all_skippers(),"Do not mix skippers with non-skippers");
+        static_assert((is_const_parser<Ps>() && ...),"Parsers must be callable as const");
 
-        return [tup = std::tuple(ps...)](Iter b,Iter e) mutable
+        if constexpr (sizeof...(Ps) >= details::min_trie_literals && details::all_literals<Ps...>)
         {
-            return details::build_result<0,Result>(b,e,tup);
-        };
+            //  Only literals: one walk of a trie finds the first alternative
+            //  that matches. Literals fail without consuming input, so if
+            //  none match the error is that of the first alternative.
+            return [tup = std::tuple(ps...),trie = details::make_literal_trie(ps...)](Iter b,Iter e)
+                -> Parse_result<Result>
+            {
+                int const i = trie.match(b,e);
+                if (i < 0)
+                {
+                    auto res = std::get<0>(tup)(b,e);
+                    return { res.iter, res.error() };
+                }
+                return mp_with_index<sizeof...(Ps)>(static_cast<std::size_t>(i),[&](auto I)
+                    -> Parse_result<Result>
+                {
+                    auto const& p = std::get<I>(tup);
+                    using Traits = details::literal_traits<std::decay_t<decltype(p)>>;
+                    return { b + trie.key_size(i), Result{ Traits::value(p) } };
+                });
+            };
+        }
+        else
+        {
+            return [tup = std::tuple(ps...)](Iter b,Iter e)
+            {
+                return details::build_result<0,Result>(b,e,tup);
+            };
+        }
     }
 
     //  Parse one of a number of types using a std::variant as the result.
@@ -84,4 +181,71 @@ namespace qdpeg
             return choice<my_result,Ps...>(ps...);
         }
     }
+
+    //  As choice, for alternatives of which at most one can match. The
+    //  alternatives are tried in order of how often they matched before,
+    //  so the most frequent is tried first. If all fail, the error is that
+    //  of the alternative getting furthest, the earliest given on a tie.
+    template<class Result,class... Ps>
+    auto adaptive_choice(Ps ... ps)
+    {
+        using namespace boost::mp11;
+        using my_types = mp_unique<mp_list<Parsed_type<Ps>...>>;
+        using no_skippers = mp_none_of<my_types,is_skipper_t>;
+        using all_skippers = mp_all_of<my_types,is_skipper_t>;
+        static_assert(no_skippers() || all_skippers(),"Do not mix skippers with non-skippers");
+        static_assert((is_const_parser<Ps>() && ...),"Parsers must be callable as const");
+        constexpr std::size_t N = sizeof...(Ps);
+
+        return [tup = std::tuple(ps...),stats = std::make_shared<details::Choice_stats<N>>()](Iter b,Iter e)
+            -> Parse_result<Result>
+        {
+            std::uint64_t const order = stats->order.load(std::memory_order_relaxed);
+            Iter fail_iter = b;
+            Error_code fail_error = Error_code::unknown_error;
+            std::size_t fail_i = N;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                std::size_t const i = (order >> (4 * k)) & 15;
+                auto res = mp_with_index<N>(i,[&](auto I) -> Parse_result<Result>
+                {
+                    auto r = std::get<I>(tup)(b,e);
+                    if (r)
+                        return { r.iter, Result{ std::move(r.value()) } };
+                    return { r.iter, r.error(), r.committed };
+                });
+                if (res)
+                {
+                    stats->hit(i);
+                    return res;
+                }
+                if (res.committed)
+                    return { res.iter, res.error() };
+                if (fail_i == N || res.iter > fail_iter || (res.iter == fail_iter && i < fail_i))
+                {
+                    fail_iter = res.iter;
+                    fail_error = res.error();
+                    fail_i = i;
+                }
+            }
+            return { fail_iter, fail_error };
+        };
+    }
+
+    template<class... Ps>
+    auto adaptive_choice(Ps ... ps)
+    {
+        using namespace boost::mp11;
+        static_assert(sizeof...(Ps) > 0,"adaptive_choice requires at least one parser");
+
+        using my_types = mp_unique<mp_list<Parsed_type<Ps>...>>;
+        if constexpr (mp_size<my_types>() == 1)
+        {
+            return adaptive_choice<mp_front<my_types>,Ps...>(ps...);
+        }
+        else
+        {
+            return adaptive_choice<mp_rename<my_types,std::variant>,Ps...>(ps...);
+        }
+    }
 }   //  namespace qdpeg
@@ -1,7 +1,46 @@
 #pragma once    
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
+
+//  constexpr where C++20 allows it, e.g. for destructors and functions
+//  using std::vector, and inline otherwise
+#if __cplusplus >= 202002L && defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc)
+#define QDPEG_HAS_CONSTEXPR20 1
+#define QDPEG_CONSTEXPR20 constexpr
+#else
+#define QDPEG_HAS_CONSTEXPR20 0
+#define QDPEG_CONSTEXPR20 inline
+#endif
+
 namespace cpp20
 {
+    constexpr bool is_constant_evaluated() noexcept
+    {
+#if defined(__cpp_lib_is_constant_evaluated)
+        return std::is_constant_evaluated();
+#else
+        return false;
+#endif
+    }
+
+    template<class T,class... Args>
+    QDPEG_CONSTEXPR20 T* construct_at(T* p,Args&&... args)
+    {
+#if QDPEG_HAS_CONSTEXPR20
+        return std::construct_at(p,std::forward<Args>(args)...);
+#else
+        return ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+#endif
+    }
+
+    template<class T>
+    QDPEG_CONSTEXPR20 void destroy_at(T* p)
+    {
+        p->~T();
+    }
+
     template<class Container>
     constexpr auto ssize(Container const& c)
     {
@@ -0,0 +1,132 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace qdpeg
+{
+    //  A node of a concrete syntax tree: the rule that matched the text
+    //  [begin,end), as offsets into the document
+    struct Cst_node
+    {
+        std::uint32_t   rule;
+        std::uint32_t   parent;
+        std::uint32_t   begin;
+        std::uint32_t   end;
+    };
+    static_assert(std::is_trivially_copyable_v<Cst_node>);
+
+    //  The nodes of the rules matched during a parse, in pre-order in one
+    //  vector, so the descendants of a node directly follow it. Nodes are
+    //  removed by truncating the vector: when their rule fails, and when
+    //  a rule starts or ends before their end, as the parse must then
+    //  have backtracked over them.
+    class Cst
+    {
+    public:
+        static constexpr std::uint32_t no_parent = std::numeric_limits<std::uint32_t>::max();
+
+        //  Bind the tree to the document and clear it. Must be called
+        //  before each parse.
+        void rebase(Iter b) noexcept
+        {
+            base = b;
+            clear();
+        }
+
+        void clear() noexcept
+        {
+            v.clear();
+            current = no_parent;
+        }
+
+        std::vector<Cst_node> const& nodes() const noexcept { return v; }
+        std::size_t size() const noexcept { return v.size(); }
+        bool empty() const noexcept { return v.empty(); }
+        Cst_node const& operator[](std::size_t i) const noexcept { return v[i]; }
+
+        //  The index after the last descendant of node i
+        std::size_t subtree_end(std::size_t i) const noexcept
+        {
+            std::size_t k = i + 1;
+            while (k < v.size() && v[k].parent != no_parent && v[k].parent >= i)
+                ++k;
+            return k;
+        }
+
+        //  Used by rule: open a node at b, returning the enclosing node
+        std::uint32_t open(std::uint32_t id,Iter b)
+        {
+            trim(offset(b));
+            std::uint32_t const parent = current;
+            current = static_cast<std::uint32_t>(v.size());
+            v.push_back({ id, parent, offset(b), offset(b) });
+            return parent;
+        }
+
+        //  Used by rule: close the node opened last at e
+        void close(std::uint32_t parent,Iter e) noexcept
+        {
+            trim(offset(e));
+            v[current].end = offset(e);
+            current = parent;
+        }
+
+        //  Used by rule: remove the node opened last and its descendants
+        void drop(std::uint32_t parent) noexcept
+        {
+            v.resize(current);
+            current = parent;
+        }
+
+    private:
+        //  Remove the children of the open node ending after pos. The
+        //  children follow each other, so only the last ones can.
+        void trim(std::uint32_t pos) noexcept
+        {
+            std::size_t const first = current == no_parent ? 0 : std::size_t(current) + 1;
+            while (v.size() > first)
+            {
+                std::size_t child = v.size() - 1;
+                while (v[child].parent != current)
+                    child = v[child].parent;
+                if (v[child].end <= pos)
+                    break;
+                v.resize(child);
+            }
+        }
+
+        std::uint32_t offset(Iter i) const noexcept
+        {
+            return static_cast<std::uint32_t>(i - base);
+        }
+
+        Iter                    base {};
+        std::vector<Cst_node>   v;
+        std::uint32_t           current = no_parent;
+    };
+
+    //  Parse p and record it in cst as a node of rule id, the children of
+    //  which are the rules matched within p. The result of p is passed
+    //  on, so grammars for a Cst are best written with skippers.
+    template<class P>
+    auto rule(Cst& cst,std::uint32_t id,P p)
+    {
+        static_assert(is_parser<P>(),"Only parsers can be rules");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+
+        return [&cst,id,p](Iter b,Iter e) -> Parsed_return<P>
+        {
+            auto const parent = cst.open(id,b);
+            auto res = p(b,e);
+            if (res)
+                cst.close(parent,res.iter);
+            else
+                cst.drop(parent);
+            return res;
+        };
+    }
+}   //  qdpeg
@@ -0,0 +1,172 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <boost/mp11.hpp>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace qdpeg
+{
+    //  A value not computed yet: the value V a deferred parser produced
+    //  and a copy of the action F computing the result from it
+    template<class V,class F>
+    class Deferred
+    {
+    public:
+        using value_type = V;
+        using result_type = std::invoke_result_t<F const&,V&&>;
+
+        Deferred(V v,F action)
+            : val(std::move(v))
+            , act(std::move(action))
+        {}
+
+        V const& value() const noexcept { return val; }
+        result_type resolve() && { return std::as_const(act)(std::move(val)); }
+
+    private:
+        V   val;
+        F   act;
+    };
+}   //  qdpeg
+
+namespace qdpeg::details
+{
+    template<class P,class F>
+    struct Defer_parser
+    {
+        using result_type = Deferred<Parsed_type<P>,F>;
+
+        P p;
+        F f;
+
+        auto operator()(Iter b,Iter e) const -> Parse_result<result_type>
+        {
+            auto res = p(b,e);
+            if (!res) return { res.iter, res.error(), res.committed };
+            return { res.iter, result_type { std::move(res.value()), f } };
+        }
+    };
+
+    //  Resolve the Deferred values held in T, also within vectors,
+    //  optionals, tuples and variants
+    template<class T>
+    struct Resolver
+    {
+        using type = T;
+        static T run(T&& v) { return std::move(v); }
+    };
+
+    template<class V,class F>
+    struct Resolver<Deferred<V,F>>
+    {
+        using type = typename Deferred<V,F>::result_type;
+        static type run(Deferred<V,F>&& d) { return std::move(d).resolve(); }
+    };
+
+    template<class T>
+    struct Resolver<std::vector<T>>
+    {
+        using type = std::vector<typename Resolver<T>::type>;
+        static type run(std::vector<T>&& v)
+        {
+            if constexpr (std::is_same_v<type,std::vector<T>>)
+            {
+                return std::move(v);
+            }
+            else
+            {
+                type out;
+                out.reserve(v.size());
+                for (auto& elem: v)
+                    out.push_back(Resolver<T>::run(std::move(elem)));
+                return out;
+            }
+        }
+    };
+
+    template<class T>
+    struct Resolver<std::optional<T>>
+    {
+        using type = std::optional<typename Resolver<T>::type>;
+        static type run(std::optional<T>&& v)
+        {
+            if (!v)
+                return std::nullopt;
+            return Resolver<T>::run(std::move(*v));
+        }
+    };
+
+    template<class... Ts>
+    struct Resolver<std::tuple<Ts...>>
+    {
+        using type = std::tuple<typename Resolver<Ts>::type...>;
+        static type run(std::tuple<Ts...>&& v)
+        {
+            return std::apply([](auto&&... elems)
+            {
+                return type { Resolver<std::decay_t<decltype(elems)>>::run(std::move(elems))... };
+            },std::move(v));
+        }
+    };
+
+    template<class... Ts>
+    struct Resolver<std::variant<Ts...>>
+    {
+        using type = std::variant<typename Resolver<Ts>::type...>;
+        static type run(std::variant<Ts...>&& v)
+        {
+            return boost::mp11::mp_with_index<sizeof...(Ts)>(v.index(),[&](auto I)
+            {
+                using T = std::variant_alternative_t<I,std::variant<Ts...>>;
+                return type { std::in_place_index<I>, Resolver<T>::run(std::get<I>(std::move(v))) };
+            });
+        }
+    };
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    template<class T>
+    using Resolved_type = typename details::Resolver<T>::type;
+
+    //  Parse p, but postpone f: the result is a Deferred holding p's value
+    //  and a copy of f, which is only applied when it is resolved. Actions
+    //  on alternatives that are backtracked over are never run.
+    template<class P,class F>
+    auto defer(P p,F f)
+    {
+        static_assert(is_real_parser<P>(),"defer requires a real parser");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+        static_assert(std::is_invocable_v<F const&,Parsed_type<P>&&>,"The action must accept the parsed value");
+
+        return details::Defer_parser<P,F> { std::move(p), std::move(f) };
+    }
+
+    //  Run the actions of the Deferred values in v
+    template<class T>
+    Resolved_type<T> resolve(T v)
+    {
+        return details::Resolver<T>::run(std::move(v));
+    }
+
+    //  Parse p and resolve its Deferred values. Put it where the
+    //  alternatives are decided, at the top of the grammar or after a cut.
+    template<class P>
+    auto force(P p)
+    {
+        static_assert(is_real_parser<P>(),"force requires a real parser");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+        using result_type = Resolved_type<Parsed_type<P>>;
+
+        return [p](Iter b,Iter e) -> Parse_result<result_type>
+        {
+            auto res = p(b,e);
+            if (!res) return { res.iter, res.error(), res.committed };
+            return { res.iter, resolve(std::move(res.value())) };
+        };
+    }
+}   //  qdpeg
@@ -22,6 +22,11 @@ namespace qdpeg
         
         to_few,
         underflow,
-        overflow
+        overflow,
+
+        too_deep,
+        too_many_elements,
+        too_many_bytes,
+        budget_exhausted
     };
 };
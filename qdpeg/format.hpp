@@ -0,0 +1,387 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <qdpeg/symbol.hpp>
+#include <boost/mp11.hpp>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+//  Printers write values in the format their namesake parsers read. A
+//  printer has
+//      has_value               false if it prints a fixed text and takes
+//                              no value
+//      size(v)                 an upper bound of the characters written
+//      write(out,v)            writes v, which must fit, and returns the
+//                              end of the output or nullptr if v can not
+//                              be printed
+//  Printers taking no value are given a Nothing.
+namespace qdpeg::details
+{
+    template<class T,unsigned Radix>
+    struct Int_printer
+    {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T,bool>,"integer requires an integral type other than bool");
+        static constexpr bool has_value = true;
+
+        static constexpr std::size_t bound()
+        {
+            std::size_t n = 1;
+            for (auto v = std::numeric_limits<T>::max(); v >= static_cast<T>(Radix); v /= static_cast<T>(Radix))
+                ++n;
+            return n + std::is_signed_v<T>;
+        }
+
+        std::size_t size(T) const noexcept { return bound(); }
+
+        char* write(char* out,T v) const noexcept
+        {
+            return std::to_chars(out,out + bound(),v,Radix).ptr;
+        }
+    };
+
+    template<class T>
+    struct Real_printer
+    {
+        static_assert(std::is_floating_point_v<T>,"real requires a floating point type");
+        static constexpr bool has_value = true;
+
+        //  Sign, digits, point, 'e', exponent sign and exponent
+        static constexpr std::size_t bound = std::numeric_limits<T>::max_digits10 + 10;
+
+        std::size_t size(T) const noexcept { return bound; }
+
+        //  The shortest text reading back as v
+        char* write(char* out,T v) const noexcept
+        {
+            return std::to_chars(out,out + bound,v).ptr;
+        }
+    };
+
+    struct Char_printer
+    {
+        static constexpr bool has_value = false;
+
+        std::size_t size(Nothing) const noexcept { return 1; }
+
+        char* write(char* out,Nothing) const noexcept
+        {
+            *out = ch;
+            return out + 1;
+        }
+
+        char    ch;
+    };
+
+    struct Str_printer
+    {
+        static constexpr bool has_value = false;
+
+        std::size_t size(Nothing) const noexcept { return text.size(); }
+
+        char* write(char* out,Nothing) const noexcept
+        {
+            std::memcpy(out,text.data(),text.size());
+            return out + text.size();
+        }
+
+        std::string_view    text;
+    };
+
+    template<class V,class = void>
+    struct is_tuple_like: std::false_type {};
+
+    template<class V>
+    struct is_tuple_like<V,std::void_t<decltype(std::tuple_size<V>::value)>>: std::true_type {};
+
+    //  The value of the printer given the value v of an enclosing printer
+    //  and the number I of printers with values before it. Values of a
+    //  sequence are taken from a tuple, or, as seq parses values of one
+    //  type into a std::vector, by index from a container.
+    template<std::size_t I,std::size_t N,class Pr,class V>
+    decltype(auto) printer_value(V const& v)
+    {
+        if constexpr (!Pr::has_value)
+            return Nothing {};
+        else if constexpr (N == 1)
+            return v;
+        else if constexpr (is_tuple_like<V>::value)
+            return std::get<I>(v);
+        else
+            return v[I];
+    }
+
+    template<class... Prs>
+    struct Seq_printer
+    {
+        static constexpr std::size_t values = (std::size_t(Prs::has_value) + ... + 0);
+        static constexpr bool has_value = values > 0;
+
+        template<class V>
+        std::size_t size(V const& v) const
+        {
+            if (!fits(v)) return 0;
+            return size_x<0,0>(v);
+        }
+
+        template<class V>
+        char* write(char* out,V const& v) const
+        {
+            if (!fits(v)) return nullptr;
+            return write_x<0,0>(out,v);
+        }
+
+        std::tuple<Prs...>  prs;
+
+    private:
+        //  A container must hold a value for each printer
+        template<class V>
+        static bool fits(V const& v [[maybe_unused]])
+        {
+            if constexpr (values > 1 && !is_tuple_like<V>::value)
+                return std::size(v) == values;
+            else
+                return true;
+        }
+
+        template<std::size_t I,std::size_t K,class V>
+        std::size_t size_x(V const& v [[maybe_unused]]) const
+        {
+            if constexpr (I == sizeof...(Prs))
+            {
+                return 0;
+            }
+            else
+            {
+                using Pr = std::tuple_element_t<I,std::tuple<Prs...>>;
+                return std::get<I>(prs).size(printer_value<K,values,Pr>(v))
+                    + size_x<I + 1,K + Pr::has_value>(v);
+            }
+        }
+
+        template<std::size_t I,std::size_t K,class V>
+        char* write_x(char* out,V const& v [[maybe_unused]]) const
+        {
+            if constexpr (I == sizeof...(Prs))
+            {
+                return out;
+            }
+            else
+            {
+                using Pr = std::tuple_element_t<I,std::tuple<Prs...>>;
+                out = std::get<I>(prs).write(out,printer_value<K,values,Pr>(v));
+                if (!out) return nullptr;
+                return write_x<I + 1,K + Pr::has_value>(out,v);
+            }
+        }
+    };
+
+    //  Alternative i of a std::variant is printed by printer i
+    template<class... Prs>
+    struct Choice_printer
+    {
+        static_assert((Prs::has_value && ...),"All alternatives of a choice must print a value");
+        static constexpr bool has_value = true;
+
+        template<class V>
+        std::size_t size(V const& v) const
+        {
+            if (v.valueless_by_exception())
+                return 0;
+            return boost::mp11::mp_with_index<sizeof...(Prs)>(v.index(),[&](auto I)
+            {
+                return std::get<I>(prs).size(std::get<I>(v));
+            });
+        }
+
+        template<class V>
+        char* write(char* out,V const& v) const
+        {
+            if (v.valueless_by_exception())
+                return nullptr;
+            return boost::mp11::mp_with_index<sizeof...(Prs)>(v.index(),[&](auto I)
+            {
+                return std::get<I>(prs).write(out,std::get<I>(v));
+            });
+        }
+
+        std::tuple<Prs...>  prs;
+    };
+
+    template<class Pr,class Sep>
+    struct Repeat_printer
+    {
+        static_assert(Pr::has_value,"repeat requires a printer of values");
+        static_assert(!Sep::has_value,"The separator must be a literal");
+        static constexpr bool has_value = true;
+
+        template<class V>
+        std::size_t size(V const& v) const
+        {
+            std::size_t n = 0;
+            for (auto const& elem: v)
+                n += pr.size(elem) + sep.size(Nothing {});
+            return n;
+        }
+
+        template<class V>
+        char* write(char* out,V const& v) const
+        {
+            bool first = true;
+            for (auto const& elem: v)
+            {
+                if (!first)
+                    out = sep.write(out,Nothing {});
+                first = false;
+                out = pr.write(out,elem);
+                if (!out) return nullptr;
+            }
+            return out;
+        }
+
+        Pr      pr;
+        Sep     sep;
+    };
+
+    //  An empty separator
+    struct Empty_printer
+    {
+        static constexpr bool has_value = false;
+        std::size_t size(Nothing) const noexcept { return 0; }
+        char* write(char* out,Nothing) const noexcept { return out; }
+    };
+
+    template<class Pr>
+    struct Opt_printer
+    {
+        static_assert(Pr::has_value,"opt requires a printer of values");
+        static constexpr bool has_value = true;
+
+        template<class V>
+        std::size_t size(V const& v) const
+        {
+            return v ? pr.size(*v) : 0;
+        }
+
+        template<class V>
+        char* write(char* out,V const& v) const
+        {
+            return v ? pr.write(out,*v) : out;
+        }
+
+        Pr      pr;
+    };
+
+    //  Prints the name of a value. The lookup is linear in the number of
+    //  symbols.
+    template<class K,class V>
+    struct Symbol_printer
+    {
+        static constexpr bool has_value = true;
+
+        std::size_t size(V const& v) const
+        {
+            auto name = sym.name_of(v);
+            return name ? name->size() : 0;
+        }
+
+        char* write(char* out,V const& v) const
+        {
+            auto name = sym.name_of(v);
+            if (!name) return nullptr;
+            std::memcpy(out,name->begin(),name->size());
+            return out + name->size();
+        }
+
+        Symbol_x<K,V>   sym;
+    };
+}   //  namespace qdpeg::details
+
+//  Printers matching the parsers of the same names
+namespace qdpeg::fmt
+{
+    template<class T,unsigned Radix = 10>
+    inline constexpr details::Int_printer<T,Radix> integer {};
+
+    template<class T>
+    inline constexpr details::Real_printer<T> real {};
+
+    inline auto lit(char ch)
+    {
+        return details::Char_printer { ch };
+    }
+
+    template<std::size_t N>
+    auto lit(char const (&text)[N])
+    {
+        return details::Str_printer { std::string_view(text,N - 1) };
+    }
+
+    template<class... Prs>
+    auto seq(Prs... prs)
+    {
+        return details::Seq_printer<Prs...> { { std::move(prs)... } };
+    }
+
+    template<class... Prs>
+    auto choice(Prs... prs)
+    {
+        return details::Choice_printer<Prs...> { { std::move(prs)... } };
+    }
+
+    template<class Pr>
+    auto repeat(Pr pr)
+    {
+        return details::Repeat_printer<Pr,details::Empty_printer> { std::move(pr), {} };
+    }
+
+    template<class Pr,class Sep>
+    auto repeat(Pr pr,Sep sep)
+    {
+        return details::Repeat_printer<Pr,Sep> { std::move(pr), std::move(sep) };
+    }
+
+    template<class Pr>
+    auto opt(Pr pr)
+    {
+        return details::Opt_printer<Pr> { std::move(pr) };
+    }
+
+    template<class K,class V>
+    auto symbol(details::Symbol_x<K,V> const& sym)
+    {
+        return details::Symbol_printer<K,V> { sym };
+    }
+}   //  namespace qdpeg::fmt
+
+namespace qdpeg
+{
+    //  An upper bound of the characters format writes for v
+    template<class Pr,class V = Nothing>
+    std::size_t format_size(Pr const& pr,V const& v = {})
+    {
+        return pr.size(v);
+    }
+
+    //  Print v into [first,last) as std::to_chars does. Fails with
+    //  value_too_large if the range is shorter than format_size, and with
+    //  invalid_argument if v has no text, e.g. a value not in a symbol
+    //  table.
+    template<class Pr,class V = Nothing>
+    std::to_chars_result format(char* first,char* last,Pr const& pr,V const& v = {})
+    {
+        if (pr.size(v) > static_cast<std::size_t>(last - first))
+            return { last, std::errc::value_too_large };
+        char* end = pr.write(first,v);
+        if (!end)
+            return { last, std::errc::invalid_argument };
+        return { end, std::errc {} };
+    }
+}   //  qdpeg
@@ -0,0 +1,215 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace qdpeg
+{
+    //  Limits on the resources of a parse of untrusted input, and the peak
+    //  use seen. A Governor belongs to one parse at a time; call reset
+    //  before each parse. Once a limit is exceeded the governor stays
+    //  tripped, so every guarded and counted parser fails until reset.
+    class Governor
+    {
+    public:
+        static constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+        std::size_t max_depth = 1000;       //  Nesting of guard
+        std::size_t max_elements = unlimited;
+        std::size_t max_bytes = unlimited;  //  Estimated memory of the counted elements
+        std::size_t max_steps = unlimited;  //  Calls of guarded and counted parsers
+
+        void reset() noexcept
+        {
+            cur_depth = 0;
+            top_depth = 0;
+            n_elements = 0;
+            n_bytes = 0;
+            n_steps = 0;
+            stack_base = 0;
+            top_stack = 0;
+            err = Error_code::no_error;
+        }
+
+        //  The limit that stopped the parse, or no_error
+        Error_code error() const noexcept { return err; }
+        bool exceeded() const noexcept { return err != Error_code::no_error; }
+
+        std::size_t depth() const noexcept { return cur_depth; }
+        std::size_t peak_depth() const noexcept { return top_depth; }
+        std::size_t elements() const noexcept { return n_elements; }
+        std::size_t bytes() const noexcept { return n_bytes; }
+        std::size_t steps() const noexcept { return n_steps; }
+
+        //  The deepest stack seen, in bytes from the frame of the
+        //  outermost guard to that of the innermost
+        std::size_t peak_stack() const noexcept { return top_stack; }
+
+        //  Used by guard, with the address of a local of the guarding frame
+        Error_code enter(void const* frame) noexcept
+        {
+            if (!step())
+                return err;
+            if (cur_depth == max_depth)
+                return trip(Error_code::too_deep);
+            auto const addr = reinterpret_cast<std::uintptr_t>(frame);
+            if (cur_depth++ == 0)
+                stack_base = addr;
+            top_depth = std::max(top_depth,cur_depth);
+            top_stack = std::max(top_stack,addr < stack_base ? stack_base - addr : addr - stack_base);
+            return Error_code::no_error;
+        }
+
+        void leave() noexcept { --cur_depth; }
+
+        //  Used by counted for each element parsed
+        Error_code add(std::size_t size) noexcept
+        {
+            if (n_elements == max_elements)
+                return trip(Error_code::too_many_elements);
+            if (size > max_bytes - n_bytes)
+                return trip(Error_code::too_many_bytes);
+            ++n_elements;
+            n_bytes += size;
+            return Error_code::no_error;
+        }
+
+        bool step() noexcept
+        {
+            if (exceeded())
+                return false;
+            if (n_steps == max_steps)
+            {
+                trip(Error_code::budget_exhausted);
+                return false;
+            }
+            ++n_steps;
+            return true;
+        }
+
+    private:
+        Error_code trip(Error_code ec) noexcept
+        {
+            err = ec;
+            return ec;
+        }
+
+        std::size_t     cur_depth = 0;
+        std::size_t     top_depth = 0;
+        std::size_t     n_elements = 0;
+        std::size_t     n_bytes = 0;
+        std::size_t     n_steps = 0;
+        std::uintptr_t  stack_base = 0;
+        std::size_t     top_stack = 0;
+        Error_code      err = Error_code::no_error;
+    };
+}   //  qdpeg
+
+namespace qdpeg::details
+{
+    template<class T,class = void>
+    struct has_heap_size: std::false_type {};
+
+    template<class T>
+    struct has_heap_size<T,std::void_t<typename T::value_type,
+        decltype(std::declval<T const&>().size()),
+        decltype(std::declval<T const&>().capacity())>>: std::true_type {};
+
+    //  The size of v including what a container or string owns, but not
+    //  what its elements own
+    template<class T>
+    std::size_t element_size(T const& v [[maybe_unused]]) noexcept
+    {
+        if constexpr (has_heap_size<T>::value)
+            return sizeof(T) + v.capacity() * sizeof(typename T::value_type);
+        else
+            return sizeof(T);
+    }
+
+    //  Leaves the level a guard entered, also when its parser throws
+    struct Governor_level
+    {
+        Governor& gov;
+        ~Governor_level() { gov.leave(); }
+    };
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    //  Parse p one level deeper. Wrap the recursive rules of a grammar, so
+    //  nesting beyond gov.max_depth fails with too_deep instead of
+    //  overflowing the stack. A failure from the governor is committed, so
+    //  the enclosing choices do not retry.
+    template<class P>
+    auto guard(Governor& gov,P p)
+    {
+        static_assert(is_parser<P>(),"Only parsers can be guarded");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+
+        return [&gov,p](Iter b,Iter e) -> Parsed_return<P>
+        {
+            char frame = 0;
+            auto ec = gov.enter(&frame);
+            if (ec != Error_code::no_error)
+                return { b, ec, true };
+            details::Governor_level const level { gov };
+            auto res = p(b,e);
+            if (!res && gov.exceeded())
+                res.committed = true;
+            return res;
+        };
+    }
+
+    //  Parse p, counting each value as an element of gov and its size
+    //  against gov.max_bytes. Wrap the elements of repeat to bound what
+    //  untrusted input can allocate. The size of a container or string
+    //  includes its capacity, but not what its elements own.
+    template<class P>
+    auto counted(Governor& gov,P p)
+    {
+        static_assert(is_parser<P>(),"Only parsers can be counted");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+
+        return [&gov,p](Iter b,Iter e) -> Parsed_return<P>
+        {
+            if (!gov.step())
+                return { b, gov.error(), true };
+            auto res = p(b,e);
+            if (res)
+            {
+                auto ec = gov.add(details::element_size(res.value()));
+                if (ec != Error_code::no_error)
+                    return { b, ec, true };
+            }
+            else if (gov.exceeded())
+            {
+                res.committed = true;
+            }
+            return res;
+        };
+    }
+
+    //  Parse p as the whole of a parse limited by gov, which is reset
+    //  first. If a limit was exceeded the parse fails with gov.error(),
+    //  also when p succeeded: a repeat ends at an element failing with the
+    //  governor, so p may have succeeded with part of the input missing.
+    template<class P>
+    auto governed(Governor& gov,P p)
+    {
+        static_assert(is_parser<P>(),"Only parsers can be governed");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+
+        return [&gov,p](Iter b,Iter e) -> Parsed_return<P>
+        {
+            gov.reset();
+            auto res = p(b,e);
+            if (gov.exceeded())
+                return { res.iter, gov.error(), true };
+            return res;
+        };
+    }
+}   //  qdpeg
@@ -0,0 +1,328 @@
+#pragma once
+#include <qdpeg/char_class.hpp>
+#include <qdpeg/qdbase.hpp>
+#include <qdpeg/strlit.hpp>
+#include <qdpeg/whitespace.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace qdpeg::details
+{
+    //  A Thompson NFA under construction. State 0 is the start state.
+    struct Nfa
+    {
+        struct State
+        {
+            std::vector<std::pair<Char_class,int>>  edges;
+            std::vector<int>                        eps;
+        };
+
+        int add()
+        {
+            states.emplace_back();
+            return static_cast<int>(states.size()) - 1;
+        }
+        void eps(int from,int to) { states[from].eps.push_back(to); }
+        void edge(int from,Char_class const& cls,int to) { states[from].edges.push_back({ cls, to }); }
+
+        std::vector<State> states;
+    };
+}   //  namespace qdpeg::details
+
+//  Regular expressions for lexeme. Each node adds itself to an NFA
+//  between the state it is given and the state it returns.
+namespace qdpeg::re
+{
+    inline constexpr int unbounded = std::numeric_limits<int>::max();
+
+    struct Chars
+    {
+        Char_class cls;
+
+        int build(details::Nfa& nfa,int from) const
+        {
+            int to = nfa.add();
+            nfa.edge(from,cls,to);
+            return to;
+        }
+    };
+
+    struct Str
+    {
+        std::string_view    text;
+        bool                case_insensitive;
+
+        int build(details::Nfa& nfa,int from) const
+        {
+            for (char ch: text)
+            {
+                Char_class cls;
+                cls.add(ch);
+                if (case_insensitive && ch >= 'A' && ch <= 'Z')
+                    cls.add(to_lower(ch));
+                if (case_insensitive && ch >= 'a' && ch <= 'z')
+                    cls.add(static_cast<char>(ch - 'a' + 'A'));
+                from = Chars { cls }.build(nfa,from);
+            }
+            return from;
+        }
+    };
+
+    template<class... Es>
+    struct Seq
+    {
+        std::tuple<Es...> es;
+
+        int build(details::Nfa& nfa,int from) const
+        {
+            std::apply([&](auto const&... e) { ((from = e.build(nfa,from)),...); },es);
+            return from;
+        }
+    };
+
+    template<class... Es>
+    struct Alt
+    {
+        std::tuple<Es...> es;
+
+        int build(details::Nfa& nfa,int from) const
+        {
+            int const to = nfa.add();
+            std::apply([&](auto const&... e)
+            {
+                auto branch = [&](auto const& alt)
+                {
+                    int start = nfa.add();
+                    nfa.eps(from,start);
+                    nfa.eps(alt.build(nfa,start),to);
+                };
+                (branch(e),...);
+            },es);
+            return to;
+        }
+    };
+
+    template<class E>
+    struct Repeat
+    {
+        E   e;
+        int min_n;
+        int max_n;
+
+        int build(details::Nfa& nfa,int from) const
+        {
+            for (int i = 0; i < min_n; ++i)
+                from = e.build(nfa,from);
+            if (max_n == unbounded)
+            {
+                int loop = nfa.add();
+                nfa.eps(from,loop);
+                nfa.eps(e.build(nfa,loop),loop);
+                return loop;
+            }
+            int const to = nfa.add();
+            for (int i = min_n; i < max_n; ++i)
+            {
+                nfa.eps(from,to);
+                from = e.build(nfa,from);
+            }
+            nfa.eps(from,to);
+            return to;
+        }
+    };
+
+    //  The parsers and values accepted as regular expressions
+    inline Chars to_re(Char_class const& cls) { return { cls }; }
+    inline Chars to_re(char ch) { return { Char_class {}.add(ch) }; }
+    inline Chars to_re(details::Char_literal const& p) { return to_re(p.ch); }
+    template<size_t N>
+    Str to_re(char const (&s)[N]) { return { std::string_view(s,N - 1), false }; }
+    inline Str to_re(details::Literal<str_lit> const& p) { return { p.s, false }; }
+    inline Str to_re(details::Literal<ci_strlit> const& p) { return { p.s, true }; }
+    inline Chars to_re(Chars const& c) { return c; }
+    inline Str to_re(Str const& s) { return s; }
+    template<class... Es> Seq<Es...> to_re(Seq<Es...> const& e) { return e; }
+    template<class... Es> Alt<Es...> to_re(Alt<Es...> const& e) { return e; }
+    template<class E> Repeat<E> to_re(Repeat<E> const& e) { return e; }
+
+    inline Chars chars(Char_class const& cls) { return { cls }; }
+    inline Str lit(str_lit s) { return { s, false }; }
+    inline Str ci_lit(ci_strlit s) { return { s, true }; }
+
+    template<class... Es>
+    auto seq(Es const&... es)
+    {
+        return Seq<decltype(to_re(es))...> { { to_re(es)... } };
+    }
+
+    template<class... Es>
+    auto alt(Es const&... es)
+    {
+        return Alt<decltype(to_re(es))...> { { to_re(es)... } };
+    }
+
+    template<class E>
+    auto repeat(E const& e,int min_n,int max_n = unbounded)
+    {
+        return Repeat<decltype(to_re(e))> { to_re(e), min_n, max_n };
+    }
+
+    template<class E> auto opt(E const& e)  { return repeat(e,0,1); }
+    template<class E> auto star(E const& e) { return repeat(e,0); }
+    template<class E> auto plus(E const& e) { return repeat(e,1); }
+}   //  namespace qdpeg::re
+
+namespace qdpeg::details
+{
+    //  A DFA compiled from an NFA by subset construction. Characters are
+    //  mapped to classes of characters the NFA does not distinguish, so
+    //  the transition table is states times classes.
+    class Dfa
+    {
+    public:
+        explicit Dfa(Nfa const& nfa,int accept)
+        {
+            make_classes(nfa);
+
+            std::map<std::vector<int>,int> ids;
+            std::vector<std::vector<int>> sets;
+            auto id_of = [&](std::vector<int> set)
+            {
+                auto [it,inserted] = ids.try_emplace(set,static_cast<int>(sets.size()));
+                if (inserted)
+                {
+                    accepting.push_back(std::binary_search(set.begin(),set.end(),accept));
+                    sets.push_back(std::move(set));
+                    table.resize(sets.size() * width,-1);
+                }
+                return it->second;
+            };
+
+            id_of(closure(nfa,{ 0 }));
+            for (std::size_t s = 0; s < sets.size(); ++s)
+            {
+                for (int c = 1; c < width; ++c)
+                {
+                    std::vector<int> moved;
+                    for (int n: sets[s])
+                        for (auto const& [cls,to]: nfa.states[n].edges)
+                            if (cls.contains(representative[c]))
+                                moved.push_back(to);
+                    if (moved.empty())
+                        continue;
+                    int const target = id_of(closure(nfa,std::move(moved)));
+                    table[s * width + c] = target;
+                }
+            }
+        }
+
+        struct Match
+        {
+            bool    matched;
+            Iter    end;    //  The end of the longest match
+            Iter    stop;   //  Where the automaton stopped
+        };
+
+        auto longest(Iter b,Iter e) const noexcept -> Match
+        {
+            int state = 0;
+            Match res { accepting[0], b, b };
+            for (; res.stop != e; ++res.stop)
+            {
+                state = table[state * width + classes[static_cast<unsigned char>(*res.stop)]];
+                if (state < 0)
+                    break;
+                if (accepting[state])
+                {
+                    res.matched = true;
+                    res.end = res.stop + 1;
+                }
+            }
+            return res;
+        }
+
+    private:
+        static std::vector<int> closure(Nfa const& nfa,std::vector<int> set)
+        {
+            std::vector<char> seen(nfa.states.size());
+            std::vector<int> todo = set;
+            set.clear();
+            while (!todo.empty())
+            {
+                int n = todo.back();
+                todo.pop_back();
+                if (seen[n])
+                    continue;
+                seen[n] = true;
+                set.push_back(n);
+                todo.insert(todo.end(),nfa.states[n].eps.begin(),nfa.states[n].eps.end());
+            }
+            std::sort(set.begin(),set.end());
+            return set;
+        }
+
+        //  Characters that belong to exactly the same edge classes share a
+        //  class. Class 0 is the characters no edge accepts.
+        void make_classes(Nfa const& nfa)
+        {
+            std::vector<Char_class> edge_classes;
+            for (auto const& st: nfa.states)
+                for (auto const& ed: st.edges)
+                    if (std::find(edge_classes.begin(),edge_classes.end(),ed.first) == edge_classes.end())
+                        edge_classes.push_back(ed.first);
+
+            std::map<std::vector<bool>,int> signatures;
+            signatures[std::vector<bool>(edge_classes.size())] = 0;
+            representative.push_back('\0');
+            for (int u = 0; u < 256; ++u)
+            {
+                char const ch = static_cast<char>(u);
+                std::vector<bool> sig(edge_classes.size());
+                for (std::size_t i = 0; i < edge_classes.size(); ++i)
+                    sig[i] = edge_classes[i].contains(ch);
+                auto [it,inserted] = signatures.try_emplace(std::move(sig),width);
+                if (inserted)
+                {
+                    representative.push_back(ch);
+                    ++width;
+                }
+                classes[u] = static_cast<std::uint16_t>(it->second);
+            }
+        }
+
+        std::array<std::uint16_t,256>   classes {};
+        std::vector<char>               representative;
+        int                             width = 1;
+        std::vector<std::int32_t>       table;
+        std::vector<bool>               accepting;
+    };
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    //  Parse the longest prefix matching the regular expression e as Raw.
+    //  e is compiled to a DFA when the parser is created, so matching is a
+    //  single table driven pass without backtracking.
+    template<class E>
+    auto lexeme(E const& e)
+    {
+        auto const expr = re::to_re(e);
+        details::Nfa nfa;
+        nfa.add();
+        int const accept = expr.build(nfa,0);
+        return [dfa = details::Dfa(nfa,accept)](Iter b,Iter e) -> Parse_result<Raw>
+        {
+            auto const m = dfa.longest(b,e);
+            if (!m.matched)
+                return { m.stop, m.stop == e ? Error_code::unexpected_eof : Error_code::unexpected_char };
+            return { m.end, make_raw(b,m.end) };
+        };
+    }
+}   //  qdpeg
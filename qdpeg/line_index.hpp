@@ -0,0 +1,117 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace qdpeg
+{
+    //  A line and a column, both counted from 1. Columns count characters.
+    struct Text_position
+    {
+        std::size_t line;
+        std::size_t column;
+    };
+
+    //  Maps positions in a text to lines and columns, e.g. for error
+    //  messages. The start of each line is recorded the first time a
+    //  position at or after it is asked for, so the text is scanned once
+    //  and only as far as needed, and each query is a binary search.
+    //  Lines end as for eol: "\n", "\r", "\n\r" or "\r\n".
+    class Line_index
+    {
+    public:
+        Line_index(Iter b,Iter e)
+            : first(b)
+            , size(static_cast<std::size_t>(e - b))
+        {
+            starts.push_back(0);
+        }
+
+        explicit Line_index(std::string_view text)
+            : Line_index(text.begin(),text.end())
+        {}
+
+        auto position(Iter pos) -> Text_position
+        {
+            auto const off = static_cast<std::size_t>(pos - first);
+            scan_to(off + 1);
+            auto const line = static_cast<std::size_t>(
+                std::upper_bound(starts.begin(),starts.end(),off) - starts.begin());
+            return { line, off - starts[line - 1] + 1 };
+        }
+
+        //  The text of line n without its line end, empty if there is no
+        //  line n
+        auto line(std::size_t n) -> Raw
+        {
+            while (starts.size() < n && scanned < size)
+                scan_to(scanned + 1);
+            if (n == 0 || n > starts.size())
+                return {};
+            Iter const b = first + static_cast<std::ptrdiff_t>(starts[n - 1]);
+            Iter const e = std::find_if(b,first + static_cast<std::ptrdiff_t>(size),[](char ch)
+            {
+                return ch == '\n' || ch == '\r';
+            });
+            return make_raw(b,e);
+        }
+
+    private:
+        //  Characters scanned at least per extension, so that queries at
+        //  increasing positions do not each start a scan
+        static constexpr std::size_t min_scan = 4096;
+
+        void scan_to(std::size_t target)
+        {
+            if (target <= scanned)
+                return;
+            target = std::min(std::max(target,scanned + min_scan),size);
+            char const* const text = size ? &*first : nullptr;
+            std::size_t pos = scanned;
+#if defined(__SSE2__)
+            __m128i const nl = _mm_set1_epi8('\n');
+            __m128i const cr = _mm_set1_epi8('\r');
+            while (target - pos >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(text + pos));
+                unsigned ends = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_or_si128(_mm_cmpeq_epi8(v,nl),_mm_cmpeq_epi8(v,cr))));
+                if (ends == 0)
+                {
+                    pos += 16;
+                    continue;
+                }
+                pos = end_of_line(text,pos + __builtin_ctz(ends));
+                if (pos > target)
+                    break;
+            }
+#endif
+            for (; pos < target; ++pos)
+            {
+                if (text[pos] == '\n' || text[pos] == '\r')
+                    pos = end_of_line(text,pos) - 1;
+            }
+            scanned = std::max(pos,target);
+        }
+
+        //  Record the line starting after the line end at pos
+        std::size_t end_of_line(char const* text,std::size_t pos)
+        {
+            std::size_t next = pos + 1;
+            if (next < size && (text[next] == '\n' || text[next] == '\r') && text[next] != text[pos])
+                ++next;
+            starts.push_back(next);
+            return next;
+        }
+
+        Iter                        first;
+        std::size_t                 size;
+        std::size_t                 scanned = 0;
+        std::vector<std::size_t>    starts;
+    };
+}   //  qdpeg
@@ -0,0 +1,165 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <qdpeg/strlit.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace qdpeg::details
+{
+    //  Describes parsers that match a fixed string. Specializations are
+    //  placed next to the literal parsers and provide key(p), the matched
+    //  text, and value(p), the parsed value.
+    template<class P>
+    struct literal_traits
+    {
+        static constexpr bool is_literal = false;
+        static constexpr bool case_insensitive = false;
+    };
+
+    template<class... Ps>
+    inline constexpr bool all_literals = (literal_traits<Ps>::is_literal && ...);
+
+    //  Fewer literals are faster compared one by one, and their choice
+    //  stays free of allocations when constructed on the fly
+    inline constexpr std::size_t min_trie_literals = 5;
+
+    //  A trie over the keys of an ordered choice of literals. Characters
+    //  are mapped to the classes that occur in the keys, so each node only
+    //  needs a row as wide as the number of classes. If any key is case
+    //  insensitive the trie is built over lower case characters and case
+    //  sensitive keys are compared exactly when reached.
+    class Literal_trie
+    {
+    public:
+        struct Key
+        {
+            std::string         text;
+            bool                case_insensitive;
+        };
+
+        explicit Literal_trie(std::vector<Key> ks)
+            : keys(std::move(ks))
+        {
+            folded = std::any_of(keys.begin(),keys.end(),[](Key const& k) { return k.case_insensitive; });
+            for (auto const& k: keys)
+            {
+                for (char ch: k.text)
+                {
+                    auto& cls = classes[static_cast<unsigned char>(fold(ch))];
+                    if (cls == 0)
+                        cls = static_cast<std::uint16_t>(width++);
+                }
+            }
+            if (folded)
+            {
+                for (char ch = 'A'; ch <= 'Z'; ++ch)
+                    classes[static_cast<unsigned char>(ch)] = classes[static_cast<unsigned char>(to_lower(ch))];
+            }
+
+            std::vector<std::vector<int>> ends(1);
+            nodes.push_back({ no_key, 0, 0 });
+            next.resize(width);
+            for (int i = 0; i < static_cast<int>(keys.size()); ++i)
+            {
+                int node = 0;
+                nodes[0].first = std::min(nodes[0].first,i);
+                for (char ch: keys[i].text)
+                {
+                    auto& target = next[node * width + class_of(ch)];
+                    if (target == 0)
+                    {
+                        target = static_cast<std::int32_t>(nodes.size());
+                        nodes.push_back({ no_key, 0, 0 });
+                        ends.emplace_back();
+                        next.resize(nodes.size() * width);
+                    }
+                    node = next[node * width + class_of(ch)];
+                    nodes[node].first = std::min(nodes[node].first,i);
+                }
+                ends[node].push_back(i);
+            }
+            for (std::size_t n = 0; n < nodes.size(); ++n)
+            {
+                nodes[n].accept_begin = static_cast<int>(accepts.size());
+                accepts.insert(accepts.end(),ends[n].begin(),ends[n].end());
+                nodes[n].accept_end = static_cast<int>(accepts.size());
+            }
+        }
+
+        //  The index of the first key that is a prefix of [b,e), or -1.
+        //  The walk stops when no key below the node can beat the best
+        //  match found so far.
+        int match(Iter b,Iter e) const noexcept
+        {
+            int best = no_key;
+            int node = 0;
+            for (Iter pos = b;; ++pos)
+            {
+                auto const& nd = nodes[node];
+                if (nd.first >= best)
+                    break;
+                for (int a = nd.accept_begin; a != nd.accept_end && accepts[a] < best; ++a)
+                {
+                    if (verify(accepts[a],b))
+                    {
+                        best = accepts[a];
+                        break;
+                    }
+                }
+                if (pos == e)
+                    break;
+                node = next[node * width + class_of(*pos)];
+                if (node == 0)
+                    break;
+            }
+            return best == no_key ? -1 : best;
+        }
+
+        std::ptrdiff_t key_size(int i) const noexcept
+        {
+            return cpp20::ssize(keys[i].text);
+        }
+
+    private:
+        static constexpr int no_key = std::numeric_limits<int>::max();
+
+        struct Node
+        {
+            int first;          //  The smallest key index in the subtree
+            int accept_begin;   //  The keys ending here in accepts
+            int accept_end;
+        };
+
+        char fold(char ch) const noexcept { return folded ? to_lower(ch) : ch; }
+        int class_of(char ch) const noexcept { return classes[static_cast<unsigned char>(ch)]; }
+
+        bool verify(int i,Iter b) const noexcept
+        {
+            auto const& k = keys[i];
+            return !folded || k.case_insensitive || k.text.empty()
+                || std::memcmp(&*b,k.text.data(),k.text.size()) == 0;
+        }
+
+        std::vector<Key>                keys;
+        bool                            folded = false;
+        std::array<std::uint16_t,256>   classes {};
+        int                             width = 1;
+        std::vector<std::int32_t>       next;
+        std::vector<Node>               nodes;
+        std::vector<int>                accepts;
+    };
+
+    template<class... Ps>
+    Literal_trie make_literal_trie(Ps const&... ps)
+    {
+        return Literal_trie({ Literal_trie::Key {
+            std::string(literal_traits<Ps>::key(ps)),
+            literal_traits<Ps>::case_insensitive }... });
+    }
+}   //  namespace qdpeg::details
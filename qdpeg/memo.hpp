@@ -0,0 +1,209 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace qdpeg
+{
+    //  Memoized results of a single rule, keyed on the offset into the
+    //  document where the rule was tried.
+    //  The table is split at a gap: entries before the gap are keyed on
+    //  their distance from the start of the document, entries after it on
+    //  their distance from the end. An edit moves the gap to the edit
+    //  position, so only the entries between two consecutive edits are
+    //  rekeyed and entries after the edit shift for free.
+    template<class T>
+    class Memo_table
+    {
+    public:
+        using result_type = Parse_result<T>;
+
+        //  Bind the table to the current document. Must be called before
+        //  parsing and whenever the document has been moved in memory.
+        void rebase(Iter b,Iter e) noexcept
+        {
+            base = b;
+            doc_size = e - b;
+        }
+
+        auto find(Iter b) const -> std::optional<result_type>
+        {
+            auto pos = b - base;
+            auto const& part = pos < gap ? front : back;
+            auto it = part.find(pos < gap ? pos : doc_size - pos);
+            if (it == part.end())
+                return std::nullopt;
+            result_type res = it->second.result;
+            res.iter = b + it->second.length;
+            return res;
+        }
+
+        void insert(Iter b,result_type const& res)
+        {
+            auto pos = b - base;
+            auto length = res.iter - b;
+            max_length = std::max(max_length,length);
+            auto& part = pos < gap ? front : back;
+            part.insert_or_assign(pos < gap ? pos : doc_size - pos,Entry { length, res });
+        }
+
+        //  The text [pos,pos + removed) has been replaced by inserted
+        //  characters. Entries whose consumed span touches the removed text
+        //  are dropped, entries after it keep their distance from the end.
+        void edit(std::ptrdiff_t pos,std::ptrdiff_t removed,std::ptrdiff_t inserted)
+        {
+            move_gap(pos);
+
+            //  Entries before pos that consumed up to or into the edit
+            for (auto it = front.lower_bound(pos - max_length); it != front.end();)
+            {
+                if (it->first + it->second.length >= pos)
+                    it = front.erase(it);
+                else
+                    ++it;
+            }
+            //  Entries starting in the removed text
+            back.erase(back.upper_bound(doc_size - pos - removed),
+                       back.upper_bound(doc_size - pos));
+
+            doc_size += inserted - removed;
+        }
+
+        //  Drop the entries before b. Only valid when no parser will
+        //  backtrack to before b, e.g. after a cut.
+        void drop_before(Iter b)
+        {
+            auto pos = b - base;
+            front.erase(front.begin(),front.lower_bound(pos));
+            back.erase(back.upper_bound(doc_size - pos),back.end());
+        }
+
+        void clear() noexcept
+        {
+            front.clear();
+            back.clear();
+            gap = 0;
+            max_length = 0;
+        }
+
+        std::size_t size() const noexcept { return front.size() + back.size(); }
+
+    private:
+        struct Entry
+        {
+            std::ptrdiff_t  length;
+            result_type     result;
+        };
+        using Part = std::map<std::ptrdiff_t,Entry>;
+
+        void move_gap(std::ptrdiff_t pos)
+        {
+            if (pos < gap)
+            {
+                for (auto it = front.lower_bound(pos); it != front.end();)
+                {
+                    auto node = front.extract(it++);
+                    node.key() = doc_size - node.key();
+                    back.insert(std::move(node));
+                }
+            }
+            else
+            {
+                for (auto it = back.upper_bound(doc_size - pos); it != back.end();)
+                {
+                    auto node = back.extract(it++);
+                    node.key() = doc_size - node.key();
+                    front.insert(std::move(node));
+                }
+            }
+            gap = pos;
+        }
+
+        Iter            base {};
+        std::ptrdiff_t  doc_size = 0;
+        std::ptrdiff_t  gap = 0;
+        std::ptrdiff_t  max_length = 0;
+        Part            front;
+        Part            back;
+    };
+
+    //  Parse with p, reusing the result from table if p has already been
+    //  tried at this position.
+    template<class P>
+    auto memo(Memo_table<Parsed_type<P>>& table,P p)
+    {
+        static_assert(is_parser<P>(),"Only parsers can be memoized");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+        return [&table,p](Iter b,Iter e) -> Parsed_return<P>
+        {
+            if (auto hit = table.find(b))
+                return std::move(*hit);
+            auto res = p(b,e);
+            table.insert(b,res);
+            return res;
+        };
+    }
+
+    //  As commit(p), but also drops the entries before the commit position
+    //  from tables, bounding the memo memory to the uncommitted input.
+    template<class P,class... Ts>
+    auto commit(P p,Memo_table<Ts>&... tables)
+    {
+        static_assert(is_parser<P>(),"Only parsers accepted");
+        static_assert(sizeof...(Ts) > 0,"commit requires at least one memo table");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+        return [p,&tables...](Iter b,Iter e) -> Parsed_return<P>
+        {
+            (tables.drop_before(b),...);
+            auto res = p(b,e);
+            if (!res)
+                res.committed = true;
+            return res;
+        };
+    }
+
+    //  A document together with the memo tables of its rules. Edits
+    //  invalidate only the memoized results near the edit, so reparsing
+    //  redoes the work around the change and reuses everything else.
+    template<class... Ts>
+    class Incremental_parse
+    {
+    public:
+        explicit Incremental_parse(std::string text)
+            : doc(std::move(text))
+        {}
+
+        template<std::size_t I>
+        auto& table() noexcept { return std::get<I>(tables); }
+
+        std::string const& text() const noexcept { return doc; }
+
+        void edit(std::size_t pos,std::size_t removed,std::string_view inserted)
+        {
+            doc.replace(pos,removed,inserted);
+            std::apply([&](auto&... tab)
+            {
+                (tab.edit(static_cast<std::ptrdiff_t>(pos),
+                          static_cast<std::ptrdiff_t>(removed),
+                          cpp20::ssize(inserted)),...);
+            },tables);
+        }
+
+        template<class P>
+        auto operator()(P&& p) -> Parsed_return<std::decay_t<P>>
+        {
+            std::string_view sv { doc };
+            std::apply([&](auto&... tab) { (tab.rebase(sv.begin(),sv.end()),...); },tables);
+            return p(sv.begin(),sv.end());
+        }
+
+    private:
+        std::string                     doc;
+        std::tuple<Memo_table<Ts>...>   tables;
+    };
+}   //  qdpeg
@@ -0,0 +1,231 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#if defined(_MSC_VER)
+#include <cstdlib>
+#endif
+
+namespace qdpeg::details
+{
+    template<std::size_t N>
+    struct uint_of_size;
+
+    template<> struct uint_of_size<1> { using type = std::uint8_t; };
+    template<> struct uint_of_size<2> { using type = std::uint16_t; };
+    template<> struct uint_of_size<4> { using type = std::uint32_t; };
+    template<> struct uint_of_size<8> { using type = std::uint64_t; };
+
+    template<class U>
+    inline U byte_swap(U v) noexcept
+    {
+#if defined(_MSC_VER)
+        if constexpr (sizeof(U) == 2)
+            return _byteswap_ushort(v);
+        else if constexpr (sizeof(U) == 4)
+            return _byteswap_ulong(v);
+        else if constexpr (sizeof(U) == 8)
+            return _byteswap_uint64(v);
+        else
+            return v;
+#else
+        if constexpr (sizeof(U) == 2)
+            return __builtin_bswap16(v);
+        else if constexpr (sizeof(U) == 4)
+            return __builtin_bswap32(v);
+        else if constexpr (sizeof(U) == 8)
+            return __builtin_bswap64(v);
+        else
+            return v;
+#endif
+    }
+
+    //  Load a T stored in the given byte order from b, which need not be
+    //  aligned
+    template<class T,bool big_endian>
+    auto parse_endian(Iter b,Iter e) -> Parse_result<T>
+    {
+        static_assert(std::is_arithmetic_v<T>,"Only arithmetic types have a byte order");
+        using U = typename uint_of_size<sizeof(T)>::type;
+        if (e - b < static_cast<std::ptrdiff_t>(sizeof(T)))
+            return { e, Error_code::unexpected_eof };
+        U u;
+        std::memcpy(&u,&*b,sizeof u);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        if constexpr (!big_endian)
+#else
+        if constexpr (big_endian)
+#endif
+            u = byte_swap(u);
+        T v;
+        std::memcpy(&v,&u,sizeof v);
+        return { b + sizeof(T), v };
+    }
+
+    template<class T>
+    constexpr bool is_pod_v = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    //  A little endian integer or floating point number
+    template<class T>
+    auto le(Iter b,Iter e) -> Parse_result<T>
+    {
+        return details::parse_endian<T,false>(b,e);
+    }
+
+    //  A big endian (network order) integer or floating point number
+    template<class T>
+    auto be(Iter b,Iter e) -> Parse_result<T>
+    {
+        return details::parse_endian<T,true>(b,e);
+    }
+
+    //  A LEB128 varint as used by protobuf. A signed T is read as the sign
+    //  extended 64-bit two's complement, so a negative protobuf int32 takes
+    //  ten bytes. Values not fitting T fail with overflow.
+    template<class T>
+    auto varint(Iter b,Iter e) -> Parse_result<T>
+    {
+        static_assert(std::is_integral_v<T>,"varint requires an integral type");
+        if constexpr (std::is_signed_v<T>)
+        {
+            auto res = varint<std::uint64_t>(b,e);
+            if (!res) return { res.iter, res.error() };
+            auto const v = static_cast<std::int64_t>(res.value());
+            if (v < std::numeric_limits<T>::min() || v > std::numeric_limits<T>::max())
+                return { b, Error_code::overflow };
+            return { res.iter, static_cast<T>(v) };
+        }
+        else
+        {
+            constexpr int bits = std::numeric_limits<T>::digits;
+            constexpr int max_bytes = (bits + 6) / 7;
+            T v = 0;
+            for (int i = 0; i < max_bytes; ++i)
+            {
+                if (b + i == e)
+                    return { e, Error_code::unexpected_eof };
+                auto const byte = static_cast<unsigned char>(b[i]);
+                T const part = byte & 0x7f;
+                if (i == max_bytes - 1 && (part >> (bits - 7 * i)) != 0)
+                    return { b, Error_code::overflow };
+                v |= static_cast<T>(part << (7 * i));
+                if ((byte & 0x80) == 0)
+                    return { b + i + 1, v };
+            }
+            return { b, Error_code::overflow };
+        }
+    }
+
+    //  A zigzag encoded varint, protobuf's sint32 and sint64
+    template<class T>
+    auto zigzag(Iter b,Iter e) -> Parse_result<T>
+    {
+        static_assert(std::is_integral_v<T> && std::is_signed_v<T>,"zigzag requires a signed type");
+        using U = std::make_unsigned_t<T>;
+        auto res = varint<U>(b,e);
+        if (!res) return { res.iter, res.error() };
+        U const u = res.value();
+        return { res.iter, static_cast<T>((u >> 1) ^ (U(0) - (u & 1))) };
+    }
+
+    //  A trivially copyable T, e.g. a struct or std::array of integers, in
+    //  the layout of the host
+    template<class T>
+    auto pod(Iter b,Iter e) -> Parse_result<T>
+    {
+        static_assert(details::is_pod_v<T>,"pod requires a trivially copyable type");
+        if (e - b < static_cast<std::ptrdiff_t>(sizeof(T)))
+            return { e, Error_code::unexpected_eof };
+        T v;
+        std::memcpy(&v,&*b,sizeof v);
+        return { b + sizeof(T), v };
+    }
+
+    namespace details
+    {
+        //  The number of bytes given by the integer n if that many remain
+        template<class N>
+        bool fits(N n,std::size_t size,Iter b,Iter e)
+        {
+            if constexpr (std::is_signed_v<N>)
+            {
+                if (n < 0)
+                    return false;
+            }
+            auto const count = static_cast<std::make_unsigned_t<N>>(n);
+            return count <= static_cast<std::size_t>(e - b) / size;
+        }
+    }   //  namespace details
+
+    //  A count parsed by count_p followed by that many Ts in the layout of
+    //  the host, copied in one go
+    template<class T,class P>
+    auto pod_vector(P count_p)
+    {
+        static_assert(details::is_pod_v<T>,"pod_vector requires a trivially copyable type");
+        static_assert(is_real_parser<P>() && std::is_integral_v<Parsed_type<P>>,"The count must be parsed as an integer");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+
+        return [count_p](Iter b,Iter e) -> Parse_result<std::vector<T>>
+        {
+            auto count = count_p(b,e);
+            if (!count) return { count.iter, count.error(), count.committed };
+            if (!details::fits(count.value(),sizeof(T),count.iter,e))
+                return { count.iter, Error_code::unexpected_eof };
+            auto const n = static_cast<std::size_t>(count.value());
+            std::vector<T> v(n);
+            if (n > 0)
+                std::memcpy(v.data(),&*count.iter,n * sizeof(T));
+            return { count.iter + n * sizeof(T), std::move(v) };
+        };
+    }
+
+    //  A length parsed by len_p followed by that many bytes, as a Raw
+    template<class P>
+    auto bytes(P len_p)
+    {
+        static_assert(is_real_parser<P>() && std::is_integral_v<Parsed_type<P>>,"The length must be parsed as an integer");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+
+        return [len_p](Iter b,Iter e) -> Parse_result<Raw>
+        {
+            auto len = len_p(b,e);
+            if (!len) return { len.iter, len.error(), len.committed };
+            if (!details::fits(len.value(),1,len.iter,e))
+                return { len.iter, Error_code::unexpected_eof };
+            Iter const end = len.iter + static_cast<std::ptrdiff_t>(len.value());
+            return { end, make_raw(len.iter,end) };
+        };
+    }
+
+    //  A length parsed by len_p followed by a frame of that many bytes,
+    //  parsed by body_p. body_p sees the frame as its whole input, so it
+    //  can not read past it, and must consume all of it.
+    template<class Len,class Body>
+    auto length_prefixed(Len len_p,Body body_p)
+    {
+        static_assert(is_real_parser<Len>() && std::is_integral_v<Parsed_type<Len>>,"The length must be parsed as an integer");
+        static_assert(is_parser<Body>(),"The body must be a parser");
+        static_assert(is_const_parser<Len>() && is_const_parser<Body>(),"Parsers must be callable as const");
+
+        return [len_p,body_p](Iter b,Iter e) -> Parse_result<Parsed_type<Body>>
+        {
+            auto len = len_p(b,e);
+            if (!len) return { len.iter, len.error(), len.committed };
+            if (!details::fits(len.value(),1,len.iter,e))
+                return { len.iter, Error_code::unexpected_eof };
+            Iter const end = len.iter + static_cast<std::ptrdiff_t>(len.value());
+            auto res = body_p(len.iter,end);
+            if (res && res.iter != end)
+                return { res.iter, Error_code::expected_eof };
+            return res;
+        };
+    }
+}   //  qdpeg
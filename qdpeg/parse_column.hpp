@@ -0,0 +1,190 @@
+#pragma once
+#include <qdpeg/parse_int.hpp>
+#include <qdpeg/qdbase.hpp>
+#include <qdpeg/swar.hpp>
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace qdpeg
+{
+    //  One bit per row, set for the rows that failed to parse
+    class Error_bitmap
+    {
+    public:
+        void reset(std::size_t rows)
+        {
+            n = rows;
+            bits.assign((rows + 63) / 64,0);
+        }
+
+        void set(std::size_t row) noexcept { bits[row / 64] |= std::uint64_t(1) << (row % 64); }
+        bool test(std::size_t row) const noexcept { return (bits[row / 64] >> (row % 64)) & 1; }
+        std::size_t size() const noexcept { return n; }
+        std::vector<std::uint64_t> const& words() const noexcept { return bits; }
+
+        std::size_t count() const noexcept
+        {
+            std::size_t total = 0;
+            for (auto w: bits)
+                total += std::bitset<64>(w).count();
+            return total;
+        }
+
+    private:
+        std::size_t                 n = 0;
+        std::vector<std::uint64_t>  bits;
+    };
+}   //  qdpeg
+
+namespace qdpeg::details
+{
+    //  Rows handed to a thread at the least
+    inline constexpr std::size_t min_column_rows = 4096;
+
+    //  True if p is int_parser<T> with its default policies, which the
+    //  kernel below can replace
+    template<class T,class P>
+    bool is_plain_int_parser(P const& p [[maybe_unused]])
+    {
+        if constexpr (std::is_convertible_v<P const&,Parse_result<T>(*)(Iter,Iter)>)
+        {
+            return static_cast<Parse_result<T>(*)(Iter,Iter)>(p) == &int_parser<T>;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    //  int_parser<T> for cells of at most digits10 digits, which can not
+    //  overflow. The digits are right aligned in a buffer of '0's, so
+    //  three words are checked and converted without a loop over the
+    //  characters. Returns false if the cell must go to the parser.
+    template<class T>
+    bool column_int(std::string_view cell,T& out) noexcept
+    {
+        static_assert(std::numeric_limits<T>::digits10 <= 24);
+        char const* p = cell.data();
+        std::size_t n = cell.size();
+        bool negative = false;
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (n > 0 && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                ++p;
+                --n;
+            }
+        }
+        if (n == 0 || n > static_cast<std::size_t>(std::numeric_limits<T>::digits10))
+            return false;
+
+        char buf[24];
+        std::memset(buf,'0',sizeof buf);
+        std::memcpy(buf + sizeof buf - n,p,n);
+        std::uint64_t const w0 = swar_load(buf);
+        std::uint64_t const w1 = swar_load(buf + 8);
+        std::uint64_t const w2 = swar_load(buf + 16);
+        if ((swar_digits(w0) & swar_digits(w1) & swar_digits(w2)) != swar_high)
+            return false;
+
+        std::uint64_t const v = swar_8digits(w0) * 10000000000000000ULL
+            + swar_8digits(w1) * 100000000ULL
+            + swar_8digits(w2);
+        using U = std::make_unsigned_t<T>;
+        out = negative
+            ? static_cast<T>(U(0) - static_cast<U>(v))
+            : static_cast<T>(v);
+        return true;
+    }
+
+    //  Parse rows [first,last) of the column, returning the number of
+    //  failures. first is a multiple of 64, so chunks do not share words
+    //  of the bitmap.
+    template<bool plain_int,class P,class T>
+    std::size_t parse_rows(P const& p,std::string_view const* cells,T* out,
+        Error_bitmap& errors,std::size_t first,std::size_t last)
+    {
+        std::size_t failed = 0;
+        for (std::size_t row = first; row < last; ++row)
+        {
+            std::string_view const cell = cells[row];
+            if constexpr (plain_int)
+            {
+                if (column_int(cell,out[row]))
+                    continue;
+            }
+            auto res = p(cell.begin(),cell.end());
+            if (res && res.iter == cell.end())
+            {
+                out[row] = std::move(res.value());
+            }
+            else
+            {
+                out[row] = T {};
+                errors.set(row);
+                ++failed;
+            }
+        }
+        return failed;
+    }
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    //  Parse each cell with p into the same row of out, which must have at
+    //  least as many rows as cells, or std::length_error is thrown. A cell
+    //  fails unless p parses all of it; failed rows are set to T {} and
+    //  marked in errors. Up to threads threads share the rows. Returns the
+    //  number of failed rows. int_parser<T> with its default policies is
+    //  replaced by a kernel converting whole words; other parsers,
+    //  real_parser included, are called for each cell.
+    template<class P,class Cells,class Out>
+    std::size_t parse_column(P const& p,Cells const& cells,Out& out,Error_bitmap& errors,unsigned threads = 1)
+    {
+        static_assert(is_real_parser<P>(),"parse_column requires a real parser");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+        using T = std::remove_reference_t<decltype(*std::data(out))>;
+
+        std::size_t const rows = std::size(cells);
+        if (std::size(out) < rows)
+            throw std::length_error("parse_column: fewer rows in out than cells");
+        std::string_view const* const in = std::data(cells);
+        T* const dest = std::data(out);
+        errors.reset(rows);
+
+        auto run = [&](std::size_t first,std::size_t last) -> std::size_t
+        {
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T,bool>)
+            {
+                if (details::is_plain_int_parser<T>(p))
+                    return details::parse_rows<true>(p,in,dest,errors,first,last);
+            }
+            return details::parse_rows<false>(p,in,dest,errors,first,last);
+        };
+
+        std::size_t const max_threads = (rows + details::min_column_rows - 1) / details::min_column_rows;
+        std::size_t const n = std::max<std::size_t>(1,std::min<std::size_t>(threads,max_threads));
+        if (n == 1)
+            return run(0,rows);
+
+        std::size_t const chunk = ((rows + n - 1) / n + 63) / 64 * 64;
+        std::vector<std::future<std::size_t>> parts;
+        for (std::size_t first = chunk; first < rows; first += chunk)
+            parts.push_back(std::async(std::launch::async,run,first,std::min(first + chunk,rows)));
+        std::size_t failed = run(0,std::min(chunk,rows));
+        for (auto& part: parts)
+            failed += part.get();
+        return failed;
+    }
+}   //  qdpeg
@@ -5,20 +5,28 @@
 #include <qdpeg/repeat.hpp>
 #include <qdpeg/symbol.hpp>
 #include <qdpeg/whitespace.hpp>
+#include <algorithm>
 #include <charconv>
 #include <limits>
 
 namespace qdpeg
 {
-    inline auto parse_bool(Iter b,Iter e)
-        -> Parse_result<bool>
+    namespace details
     {
-        return choice(
+        //  Built once. A constexpr variable can not own a trie, so this
+        //  also keeps parse_bool from building one on each call.
+        inline constexpr auto bool_literals = choice(
             as(lit('0'),false),
             as(lit('1'),true),
             as(lit(ci_strlit("false")),false),
             as(lit(ci_strlit("true")),true)
-        )(b,e);
+        );
+    }
+
+    QDPEG_CONSTEXPR20 auto parse_bool(Iter b,Iter e)
+        -> Parse_result<bool>
+    {
+        return details::bool_literals(b,e);
     };
 
     //  signs for a number
@@ -50,13 +58,13 @@ namespace qdpeg
             }
             else //(sp == sign_policy::required)
             {
-                return choice(lit('-'),lit('+'));
+                return skip(char_from<'-','+'>);
             }
         }
     }
     
     template<signed char N>
-    bool is_radix_char(char ch)
+    constexpr bool is_radix_char(char ch)
     {
         static_assert(N >= 2 && N <= 36,"Unsupported radix");
 
@@ -72,6 +80,66 @@ namespace qdpeg
         }
     }
 
+    namespace details
+    {
+        //  As std::from_chars for integers, which is not constexpr before
+        //  C++23, converting by hand in constant expressions
+        template<class T>
+        constexpr auto from_chars_int(char const* first,char const* last,T& val,int base)
+            -> std::from_chars_result
+        {
+            if (!cpp20::is_constant_evaluated())
+                return std::from_chars(first,last,val,base);
+
+            using Mag = std::make_unsigned_t<T>;
+            bool const negative = std::is_signed_v<T> && first != last && *first == '-';
+            Mag const limit = negative
+                ? Mag(Mag(std::numeric_limits<T>::max()) + 1)
+                : Mag(std::numeric_limits<T>::max());
+            auto digit = [base](char ch)
+            {
+                int d = ch >= '0' && ch <= '9' ? ch - '0'
+                    : ch >= 'a' && ch <= 'z' ? ch - 'a' + 10
+                    : ch >= 'A' && ch <= 'Z' ? ch - 'A' + 10
+                    : base;
+                return d < base ? d : -1;
+            };
+
+            char const* pos = first + negative;
+            char const* const digits = pos;
+            Mag mag = 0;
+            bool overflow = false;
+            for (; pos != last && digit(*pos) >= 0; ++pos)
+            {
+                auto const d = static_cast<Mag>(digit(*pos));
+                if (mag > (limit - d) / static_cast<Mag>(base))
+                    overflow = true;
+                else
+                    mag = static_cast<Mag>(mag * static_cast<Mag>(base) + d);
+            }
+            if (pos == digits)
+                return { first, std::errc::invalid_argument };
+            if (overflow)
+                return { pos, std::errc::result_out_of_range };
+            val = negative ? static_cast<T>(Mag(0) - mag) : static_cast<T>(mag);
+            return { pos, std::errc {} };
+        }
+
+        //  Skip from min_digits to max_digits digits without collecting them.
+        //  The bounds are known up front, so no container is needed.
+        template<unsigned Radix>
+        constexpr auto skip_digits(int min_digits,int max_digits)
+        {
+            return [min_digits,max_digits](Iter b,Iter e) -> Skipper
+            {
+                Iter end = std::find_if_not(b,take(b,e,max_digits),is_radix_char<Radix>);
+                if (end - b < min_digits)
+                    return { end, Error_code::to_few };
+                return end;
+            };
+        }
+    }
+
     template <class T,
         unsigned Radix = 10,
         sign_policy sp = std::is_signed<T>()
@@ -79,16 +147,14 @@ namespace qdpeg
             : sign_policy::none,
         int MinDigits = 1,
         int MaxDigits = std::numeric_limits<int>::max()>
-    auto int_parser(Iter b,Iter e)
+    constexpr auto int_parser(Iter b,Iter e)
             -> Parse_result<T>
     {
         static_assert(MinDigits > 0 && MinDigits <= MaxDigits);
-        Iter start_pos = b;
         auto parse_digits = 
             raw(seq(
-                parse_sign<sp>(),
-                repeat(char_if(is_radix_char<Radix>),
-                       take(MinDigits,MaxDigits))
+                details::parse_sign<sp>(),
+                details::skip_digits<Radix>(MinDigits,MaxDigits)
             ));
 
         auto raw_int = parse_digits(b,e);
@@ -104,8 +170,8 @@ namespace qdpeg
                 digs.remove_prefix(1);
         }
         
-        T val;
-        auto conv_res = std::from_chars(digs.data(),
+        T val {};
+        auto conv_res = details::from_chars_int(digs.data(),
             digs.data() + digs.size(),
             val,
             Radix);
@@ -152,14 +218,14 @@ namespace qdpeg
                           || decimals_min > 0)
             {
                 return seq(char_from<'.'>,
-                           repeat(digit(),take(decimals_min,decimals_max))
+                           skip_digits<10>(decimals_min,decimals_max)
                 );
             }
             else 
             {
                 return choice(
                     seq(char_from<'.'>,
-                        repeat(digit(),take(decimals_min,decimals_max))
+                        skip_digits<10>(decimals_min,decimals_max)
                     ),
                     empty);
             }
@@ -218,7 +284,11 @@ namespace qdpeg
                 {"-inf", Inf_nan::minus_inf },
             };
 
-            return as(inf_nan_symbols,inf_nan_to_real<Real>)(b,e);
+            //  Not as(inf_nan_symbols,...), which would copy the symbols
+            auto res = inf_nan_symbols(b,e);
+            if (!res)
+                return { res.iter, res.error() };
+            return { res.iter, inf_nan_to_real<Real>(res.value()) };
         }
 
         template<class Real,
@@ -240,7 +310,7 @@ namespace qdpeg
         {
             return seq(ci_lit("e"),
                 choice(lit('-'),lit('+'),empty),
-                repeat(digit(),at_least(1)));
+                skip_digits<10>(1,std::numeric_limits<int>::max()));
         }
 
         template<exp_policy ep>
@@ -282,7 +352,7 @@ namespace qdpeg
             //  parse sign,digits,decimals, exponent
             return raw(seq(
                 details::parse_sign<sp>(),
-                repeat(digit(),take(digits_min,digits_max)),
+                details::skip_digits<10>(digits_min,digits_max),
                 details::parse_decimals<dec_p,decimals_min,decimals_max>(),
                 details::parse_exponent<exp_p>()
             ))(b,e);
@@ -355,4 +425,90 @@ namespace qdpeg
                 decimals_max,digits_max>)(b,e);
     }
 
+    //  Parse a decimal number as an integer scaled by 10^Scale, e.g. "12.3"
+    //  parses to 12300 for Scale 3. The value is accumulated in a single
+    //  pass. A value that does not fit in Int fails with overflow and
+    //  non-zero digits beyond Scale decimals fail with underflow, as does
+    //  a minus for an unsigned Int.
+    template<class Int,
+        int Scale,
+        sign_policy sp          = std::is_signed<Int>()
+                                ? sign_policy::allowed
+                                : sign_policy::none,
+        decpoint_policy dec_p   = decpoint_policy::allow_point,
+        int  decimals_min       = 0,
+        int  decimals_max       = std::numeric_limits<int>::max()>
+    constexpr auto decimal_parser(Iter b,Iter e) -> Parse_result<Int>
+    {
+        static_assert(std::numeric_limits<Int>::is_integer,"decimal_parser requires an integral type");
+        static_assert(Scale >= 0 && Scale < std::numeric_limits<Int>::digits10,
+            "Scale does not fit in the integral type");
+        static_assert(decimals_min >= 0 && decimals_min <= decimals_max,
+            "Invalid decimals specification for decimal_parser");
+        using Mag = std::make_unsigned_t<Int>;
+
+        auto sign = details::parse_sign<sp>()(b,e);
+        if (!sign)
+            return { sign.iter, sign.error() };
+        bool const negative = sign.iter != b && *b == '-';
+        if (!std::numeric_limits<Int>::is_signed && negative)
+            return { b, Error_code::underflow };
+        Mag const limit = negative
+            ? Mag(Mag(std::numeric_limits<Int>::max()) + Mag(std::numeric_limits<Int>::is_signed))
+            : Mag(std::numeric_limits<Int>::max());
+
+        Mag mag = 0;
+        auto add_digit = [&](char ch)
+        {
+            Mag d = static_cast<Mag>(ch - '0');
+            if (mag > (limit - d) / 10)
+                return false;
+            mag = mag * 10 + d;
+            return true;
+        };
+
+        Iter pos = sign.iter;
+        Iter digits_begin = pos;
+        for (; pos != e && is_radix_char<10>(*pos); ++pos)
+        {
+            if (!add_digit(*pos))
+                return { pos, Error_code::overflow };
+        }
+        bool const has_digits = pos != digits_begin;
+
+        int decimals = 0;
+        if (pos != e && *pos == '.' && (has_digits || (pos + 1 != e && is_radix_char<10>(pos[1]))))
+        {
+            ++pos;
+            for (; pos != e && decimals < decimals_max && is_radix_char<10>(*pos); ++pos,++decimals)
+            {
+                if (decimals < Scale)
+                {
+                    if (!add_digit(*pos))
+                        return { pos, Error_code::overflow };
+                }
+                else if (*pos != '0')
+                {
+                    return { pos, Error_code::underflow };
+                }
+            }
+            if (decimals < decimals_min)
+                return { pos, Error_code::to_few };
+        }
+        else if (!has_digits)
+        {
+            return { pos, pos == e ? Error_code::unexpected_eof : Error_code::unexpected_char };
+        }
+        else if (dec_p == decpoint_policy::require_point || decimals_min > 0)
+        {
+            return { pos, Error_code::expected_char };
+        }
+
+        for (; decimals < Scale; ++decimals)
+        {
+            if (!add_digit('0'))
+                return { pos, Error_code::overflow };
+        }
+        return { pos, negative ? static_cast<Int>(Mag(0) - mag) : static_cast<Int>(mag) };
+    }
 }
@@ -0,0 +1,137 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <qdpeg/swar.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace qdpeg::details
+{
+    inline int hex_value(char ch) noexcept
+    {
+        if (ch >= '0' && ch <= '9') return ch - '0';
+        if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+        if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+        return -1;
+    }
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    //  A dotted quad IPv4 address as a host order integer. The at most 15
+    //  characters are classified as two words, so the fields are found
+    //  without testing one character at a time.
+    inline auto ipv4_parser(Iter b,Iter e) -> Parse_result<std::uint32_t>
+    {
+        using namespace details;
+        char buf[16] {};
+        auto const n = static_cast<int>(std::min<std::ptrdiff_t>(e - b,16));
+        if (n > 0)
+            std::memcpy(buf,&*b,static_cast<size_t>(n));
+        unsigned const digits = swar_bits(swar_digits(swar_load(buf)))
+            | swar_bits(swar_digits(swar_load(buf + 8))) << 8;
+
+        auto fail = [&](int at,Error_code ec) -> Parse_result<std::uint32_t>
+        {
+            return { b + at, at == n ? Error_code::unexpected_eof : ec };
+        };
+        std::uint32_t addr = 0;
+        int pos = 0;
+        for (int field = 0; field < 4; ++field)
+        {
+            if (field > 0)
+            {
+                if (buf[pos] != '.')
+                    return fail(pos,Error_code::expected_char);
+                ++pos;
+            }
+            int const len = count_trailing_zeros(~(digits >> pos));
+            if (len == 0)
+                return fail(pos,Error_code::unexpected_char);
+            if (len > 3)
+                return fail(pos,Error_code::overflow);
+            unsigned v = 0;
+            for (int i = 0; i < len; ++i)
+                v = v * 10 + static_cast<unsigned>(buf[pos + i] - '0');
+            if (v > 255)
+                return fail(pos,Error_code::overflow);
+            addr = addr << 8 | v;
+            pos += len;
+        }
+        return { b + pos, addr };
+    }
+
+    //  An IPv6 address in network byte order, with :: compression and an
+    //  optional dotted quad for the last 32 bits
+    inline auto ipv6_parser(Iter b,Iter e) -> Parse_result<std::array<std::uint8_t,16>>
+    {
+        using details::hex_value;
+        auto fail = [e](Iter at) -> Parse_result<std::array<std::uint8_t,16>>
+        {
+            return { at, at == e ? Error_code::unexpected_eof : Error_code::unexpected_char };
+        };
+
+        std::uint16_t groups[8] {};
+        int count = 0;
+        int gap = -1;
+        Iter pos = b;
+        if (pos != e && *pos == ':')
+        {
+            if (e - pos < 2 || pos[1] != ':')
+                return fail(pos + 1);
+            pos += 2;
+            gap = 0;
+        }
+        while (count < 8 && pos != e && hex_value(*pos) >= 0)
+        {
+            Iter const group = pos;
+            unsigned v = 0;
+            for (; pos != e && pos - group < 4 && hex_value(*pos) >= 0; ++pos)
+                v = v * 16 + static_cast<unsigned>(hex_value(*pos));
+            if (pos != e && *pos == '.')
+            {
+                if (count > 6)
+                    return fail(pos);
+                auto quad = ipv4_parser(group,e);
+                if (!quad)
+                    return { quad.iter, quad.error() };
+                groups[count++] = static_cast<std::uint16_t>(quad.value() >> 16);
+                groups[count++] = static_cast<std::uint16_t>(quad.value() & 0xffff);
+                pos = quad.iter;
+                break;
+            }
+            if (pos != e && hex_value(*pos) >= 0)
+                return { pos, Error_code::overflow };
+            groups[count++] = static_cast<std::uint16_t>(v);
+            if (count == 8 || pos == e || *pos != ':')
+                break;
+            if (e - pos >= 2 && pos[1] == ':')
+            {
+                if (gap >= 0)
+                    return { pos, Error_code::unexpected_char };
+                gap = count;
+                pos += 2;
+            }
+            else
+            {
+                if (e - pos < 2 || hex_value(pos[1]) < 0)
+                    return fail(pos + 1);
+                ++pos;
+            }
+        }
+        if (gap < 0 ? count != 8 : count > 7)
+            return fail(pos);
+
+        std::array<std::uint8_t,16> addr {};
+        int const zeros = gap < 0 ? 0 : 8 - count;
+        for (int i = 0,j = 0; i < count; ++i,++j)
+        {
+            if (i == gap)
+                j += zeros;
+            addr[2 * j] = static_cast<std::uint8_t>(groups[i] >> 8);
+            addr[2 * j + 1] = static_cast<std::uint8_t>(groups[i] & 0xff);
+        }
+        return { pos, addr };
+    }
+}   //  qdpeg
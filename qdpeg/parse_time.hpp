@@ -0,0 +1,221 @@
+#pragma once
+#include <qdpeg/parse_char.hpp>
+#include <qdpeg/qdbase.hpp>
+#include <qdpeg/swar.hpp>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <string_view>
+
+namespace qdpeg
+{
+    using Sys_days = std::chrono::time_point<std::chrono::system_clock,
+        std::chrono::duration<int,std::ratio<86400>>>;
+    using Sys_time = std::chrono::time_point<std::chrono::system_clock,std::chrono::nanoseconds>;
+
+    //  A timestamp in UTC together with the offset it was written in
+    struct Timestamp
+    {
+        Sys_time                time;
+        std::chrono::minutes    offset;
+    };
+}   //  qdpeg
+
+namespace qdpeg::details
+{
+    //  Days since 1970-01-01 of a date in the proleptic Gregorian calendar
+    constexpr int days_from_civil(int y,unsigned m,unsigned d) noexcept
+    {
+        y -= m <= 2;
+        int const era = (y >= 0 ? y : y - 399) / 400;
+        unsigned const yoe = static_cast<unsigned>(y - era * 400);
+        unsigned const doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        unsigned const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int>(doe) - 719468;
+    }
+
+    constexpr unsigned days_in_month(int y,unsigned m) noexcept
+    {
+        if (m == 2)
+            return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0) ? 29 : 28;
+        return m == 4 || m == 6 || m == 9 || m == 11 ? 30 : 31;
+    }
+
+    //  The failure at the first character of [b,e) not matching layout,
+    //  as for swar_layout
+    template<class T>
+    auto layout_error(Iter b,Iter e,std::string_view layout) -> Parse_result<T>
+    {
+        for (char l: layout)
+        {
+            if (b == e)
+                return { b, Error_code::unexpected_eof };
+            if (l == 'd' && !is_digit(*b))
+                return { b, Error_code::unexpected_char };
+            if (l != 'd' && l != '_' && *b != l)
+                return { b, Error_code::expected_char };
+            ++b;
+        }
+        return { b, Error_code::unknown_error };
+    }
+
+    //  YYYY-MM-DD as days since the epoch
+    inline auto parse_iso_date(Iter b,Iter e) -> Parse_result<int>
+    {
+        static constexpr Swar_layout head = swar_layout("dddd-dd-");
+        static constexpr Swar_layout tail = swar_layout("__-dd-dd");
+        if (e - b < 10)
+            return layout_error<int>(b,e,"dddd-dd-dd");
+        auto const v1 = swar_load(&*b);
+        auto const v2 = swar_load(&*b + 2);
+        if (!swar_match(v1,head) || !swar_match(v2,tail))
+            return layout_error<int>(b,e,"dddd-dd-dd");
+
+        int const y = static_cast<int>(swar_4digits(v1,0));
+        unsigned const m = swar_2digits(v1,5);
+        unsigned const d = swar_2digits(v2,6);
+        if (m < 1 || m > 12)
+            return { b + 5, Error_code::overflow };
+        if (d < 1 || d > days_in_month(y,m))
+            return { b + 8, Error_code::overflow };
+        return { b + 10, days_from_civil(y,m,d) };
+    }
+
+    //  HH:MM:SS[.fraction] as nanoseconds since midnight. Digits beyond
+    //  nanoseconds are consumed and ignored.
+    inline auto parse_iso_time(Iter b,Iter e) -> Parse_result<std::int64_t>
+    {
+        static constexpr Swar_layout hms = swar_layout("dd:dd:dd");
+        if (e - b < 8)
+            return layout_error<std::int64_t>(b,e,"dd:dd:dd");
+        auto const v = swar_load(&*b);
+        if (!swar_match(v,hms))
+            return layout_error<std::int64_t>(b,e,"dd:dd:dd");
+
+        unsigned const h = swar_2digits(v,0);
+        unsigned const m = swar_2digits(v,3);
+        unsigned const s = swar_2digits(v,6);
+        if (h > 23)
+            return { b, Error_code::overflow };
+        if (m > 59)
+            return { b + 3, Error_code::overflow };
+        if (s > 60)
+            return { b + 6, Error_code::overflow };
+
+        Iter pos = b + 8;
+        std::int64_t nanos = 0;
+        if (pos != e && (*pos == '.' || *pos == ','))
+        {
+            Iter const first = ++pos;
+            if (e - pos >= 8 && swar_digits(swar_load(&*pos)) == swar_high)
+            {
+                nanos = swar_8digits(swar_load(&*pos));
+                pos += 8;
+            }
+            for (; pos != e && is_digit(*pos); ++pos)
+            {
+                if (pos - first < 9)
+                    nanos = nanos * 10 + (*pos - '0');
+            }
+            if (pos == first)
+                return { pos, pos == e ? Error_code::unexpected_eof : Error_code::unexpected_char };
+            for (auto n = pos - first; n < 9; ++n)
+                nanos *= 10;
+        }
+        return { pos, ((h * 60 + m) * 60 + s) * std::int64_t(1000000000) + nanos };
+    }
+
+    //  Z, +HH:MM, +HHMM or +HH as minutes east of UTC. No offset is UTC.
+    inline auto parse_utc_offset(Iter b,Iter e) -> Parse_result<int>
+    {
+        if (b == e || (*b != '+' && *b != '-'))
+        {
+            if (b != e && (*b == 'Z' || *b == 'z'))
+                return { b + 1, 0 };
+            return { b, 0 };
+        }
+        Iter pos = b + 1;
+        if (e - pos < 2 || !is_digit(pos[0]) || !is_digit(pos[1]))
+            return layout_error<int>(pos,e,"dd");
+        int const h = (pos[0] - '0') * 10 + (pos[1] - '0');
+        pos += 2;
+        int m = 0;
+        Iter const mins = pos != e && *pos == ':' ? pos + 1 : pos;
+        if (e - mins >= 2 && is_digit(mins[0]) && is_digit(mins[1]))
+        {
+            m = (mins[0] - '0') * 10 + (mins[1] - '0');
+            pos = mins + 2;
+        }
+        else if (mins != pos)
+        {
+            return layout_error<int>(mins,e,"dd");
+        }
+        if (h > 23)
+            return { b + 1, Error_code::overflow };
+        if (m > 59)
+            return { mins, Error_code::overflow };
+        int const offset = h * 60 + m;
+        return { pos, *b == '-' ? -offset : offset };
+    }
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    //  An ISO 8601 calendar date, YYYY-MM-DD
+    inline auto date_parser(Iter b,Iter e) -> Parse_result<Sys_days>
+    {
+        auto res = details::parse_iso_date(b,e);
+        if (!res)
+            return { res.iter, res.error() };
+        return { res.iter, Sys_days { Sys_days::duration { res.value() } } };
+    }
+
+    //  An ISO 8601 timestamp, YYYY-MM-DDTHH:MM:SS[.fraction][offset], keeping
+    //  the offset. The separator may also be 't' or a space. Times outside
+    //  the range of Sys_time, about the years 1677 to 2262, fail with
+    //  overflow.
+    inline auto zoned_timestamp_parser(Iter b,Iter e) -> Parse_result<Timestamp>
+    {
+        auto date = details::parse_iso_date(b,e);
+        if (!date)
+            return { date.iter, date.error() };
+        Iter pos = date.iter;
+        if (pos == e)
+            return { pos, Error_code::unexpected_eof };
+        if (*pos != 'T' && *pos != 't' && *pos != ' ')
+            return { pos, Error_code::expected_char };
+        auto time = details::parse_iso_time(pos + 1,e);
+        if (!time)
+            return { time.iter, time.error() };
+        auto offset = details::parse_utc_offset(time.iter,e);
+        if (!offset)
+            return { offset.iter, offset.error() };
+
+        using Limits = std::numeric_limits<std::int64_t>;
+        constexpr std::int64_t ns_per_day = std::int64_t(86400) * 1000000000;
+        //  One day is moved from the days to the rest, so the days at the
+        //  ends of the range, only partly representable, are accepted
+        std::int64_t const sign = date.value() > 0 ? 1 : date.value() < 0 ? -1 : 0;
+        std::int64_t const days = date.value() - sign;
+        if (days > Limits::max() / ns_per_day || days < Limits::min() / ns_per_day)
+            return { b, Error_code::overflow };
+        std::int64_t const day_ns = days * ns_per_day;
+        std::int64_t const rest = time.value() - std::int64_t(offset.value()) * 60 * 1000000000
+            + sign * ns_per_day;
+        if (rest > 0 ? day_ns > Limits::max() - rest : day_ns < Limits::min() - rest)
+            return { b, Error_code::overflow };
+
+        std::chrono::minutes const zone { offset.value() };
+        return { offset.iter, Timestamp { Sys_time { std::chrono::nanoseconds { day_ns + rest } }, zone } };
+    }
+
+    //  As zoned_timestamp_parser, converted to UTC
+    inline auto timestamp_parser(Iter b,Iter e) -> Parse_result<Sys_time>
+    {
+        auto res = zoned_timestamp_parser(b,e);
+        if (!res)
+            return { res.iter, res.error() };
+        return { res.iter, res.value().time };
+    }
+}   //  qdpeg
@@ -41,7 +41,7 @@ namespace qdpeg
     [[noreturn]] inline void bad_parse_access() { Ascii_parse::bad_parse_access(); };
     using Iter = Ascii_parse::Iter;
     using Raw = Ascii_parse::Raw;
-    inline Raw make_raw(Iter begin,Iter end) { return Ascii_parse::make_raw(begin,end); }
+    constexpr Raw make_raw(Iter begin,Iter end) { return Ascii_parse::make_raw(begin,end); }
 
     constexpr Iter take(Iter b,Iter e,std::ptrdiff_t N) noexcept
     {
@@ -73,23 +73,55 @@ namespace qdpeg
 
     using Skipper = Parse_result<Nothing>;
 
+    namespace details
+    {
+        //  The parameter of the copy operations of a Parse_result of a
+        //  type that can not be copied, so they are not copy operations
+        struct Not_copyable;
+    }
+
     template<class T>
     struct Parse_result
     {
         using result_type = T;
+        //  Parse_result is copyable only if T is
+        using Copy_source = std::conditional_t<std::is_copy_constructible_v<T>,Parse_result,details::Not_copyable>;
     public:
-        ~Parse_result() noexcept { disengage(); }
+        QDPEG_CONSTEXPR20 ~Parse_result() noexcept { disengage(); }
         constexpr Parse_result()
             : Parse_result(std::string_view("").begin(),Error_code::unknown_error)
         {}
-        constexpr Parse_result(Parse_result const& rhs);
+        constexpr Parse_result(Copy_source const& rhs);
         constexpr Parse_result(Parse_result&& rhs) noexcept;
-        constexpr Parse_result& operator=(Parse_result const& rhs);
+        constexpr Parse_result& operator=(Copy_source const& rhs);
         constexpr Parse_result& operator=(Parse_result&& rhs) noexcept;
         constexpr Parse_result(Iter i,T v)
             : iter(i)
         {
-            new (&data.val) T(std::move(v));
+            cpp20::construct_at(&data.val,std::move(v));
+            engaged = true;
+        }
+        //  Construct the value in place as T{ args... }
+        template<class... Args>
+        constexpr Parse_result(Iter i,std::in_place_t,Args&&... args)
+            : iter(i)
+        {
+            if constexpr (sizeof...(Args) == 1
+                && (std::is_same_v<std::decay_t<Args>,T> && ...))
+            {
+                cpp20::construct_at(&data.val,std::forward<Args>(args)...);
+            }
+#if QDPEG_HAS_CONSTEXPR20
+            else if (std::is_constant_evaluated())
+            {
+                //  No placement new in constant expressions
+                cpp20::construct_at(&data.val,T{ std::forward<Args>(args)... });
+            }
+#endif
+            else
+            {
+                new (&data.val) T{ std::forward<Args>(args)... };
+            }
             engaged = true;
         }
         constexpr Parse_result(Iter i,Error_code ec)
@@ -97,7 +129,13 @@ namespace qdpeg
             
         {
             engaged = false;
-            new (&data.err_code) Error_code(ec);
+            data.err_code = ec;
+        }
+        //  Failure that keeps the commitment of the failing parser
+        constexpr Parse_result(Iter i,Error_code ec,bool commit)
+            : Parse_result(i,ec)
+        {
+            committed = commit;
         }
     
         constexpr Parse_result(Iter i) noexcept
@@ -105,7 +143,7 @@ namespace qdpeg
         {
             if constexpr (std::is_same_v<T,Nothing>)
             {
-                new (&data.val) Nothing;
+                cpp20::construct_at(&data.val);
                 engaged = true;
             }
             else
@@ -116,11 +154,11 @@ namespace qdpeg
             }
         }
     public:
-        operator Skipper() const noexcept   
+        constexpr operator Skipper() const noexcept   
         { 
             return engaged 
                 ? Skipper { iter, Nothing {} }
-                : Skipper { iter, error() };
+                : Skipper { iter, error(), committed };
         }
         constexpr operator Iter() const  noexcept     { return iter; }
         constexpr operator bool() const  noexcept     { return engaged; }
@@ -137,13 +175,15 @@ namespace qdpeg
         constexpr void assign(Parse_result&& rhs);
     public:
         bool engaged = false;
+        //  Failed after a cut: the enclosing choice must not try other alternatives
+        bool committed = false;
         Iter iter;
         union Data
         {
             Error_code  err_code;
             T           val;
-            Data(): err_code(Error_code::no_error) {}
-            ~Data() {}
+            constexpr Data(): err_code(Error_code::no_error) {}
+            QDPEG_CONSTEXPR20 ~Data() {}
         };
         Data data;
     };  //  Parse_result
@@ -154,7 +194,7 @@ namespace qdpeg
     constexpr void Parse_result<T>::disengage() noexcept
     {
         if (engaged)
-            data.val.~T();
+            cpp20::destroy_at(&data.val);
     }
 
     template<class T>
@@ -164,13 +204,14 @@ namespace qdpeg
         iter = rhs.iter;
         if (rhs_engaged)
         {
-            new(&data.val) T(std::move(rhs.data.val)); 
+            cpp20::construct_at(&data.val,std::move(rhs.data.val)); 
         }
         else
         {
             data.err_code = rhs.data.err_code;
         }
         engaged = rhs_engaged;
+        committed = rhs.committed;
     }
 
     template<class T>
@@ -180,18 +221,19 @@ namespace qdpeg
     }
 
     template<class T>
-    constexpr Parse_result<T>::Parse_result(Parse_result const& rhs)
+    constexpr Parse_result<T>::Parse_result(Copy_source const& rhs)
     {
         iter = rhs.iter;
         if (rhs.engaged)
         {
-            new(&data.val) T(rhs.data.val); 
+            cpp20::construct_at(&data.val,rhs.data.val); 
         }
         else
         {
-            new(&data.err_code) Error_code (rhs.data.err_code); 
+            data.err_code = rhs.data.err_code; 
         }
         engaged = rhs.engaged;
+        committed = rhs.committed;
     }
 
     template<class T>
@@ -203,9 +245,10 @@ namespace qdpeg
     }
 
     template<class T>
-    constexpr Parse_result<T>& Parse_result<T>::operator=(Parse_result const& rhs)
+    constexpr Parse_result<T>& Parse_result<T>::operator=(Copy_source const& rhs)
     {
         Parse_result tmp { rhs };
+        disengage();
         assign(std::move(tmp));
         return *this;
     }
@@ -271,6 +314,24 @@ namespace qdpeg
         return is_real_parser<T>(); 
     }
 
+    template<class T>
+    using const_parse_t = decltype(std::declval<T const&>()
+        (std::declval<Iter>(),std::declval<Iter>()));
+
+    //  Parsers are called through const references, so that a grammar
+    //  can be shared, e.g. between threads
+    template<class T>
+    constexpr bool is_const_parser()
+    {
+        return cpp20::is_detected<const_parse_t,T>();
+    }
+
+    template<class T>
+    constexpr bool is_const_parser(T const&)
+    {
+        return is_const_parser<T>();
+    }
+
     template<class T>
     constexpr bool is_typed()  
     { 
@@ -364,10 +425,18 @@ namespace qdpeg
 {
     struct Empty_skipper
     {
-        inline Skipper operator()(Iter b,Iter ) const { return { b, Nothing{} };}
+        QDPEG_CONSTEXPR20 Skipper operator()(Iter b,Iter ) const { return { b, Nothing{} };}
     };
     static Empty_skipper empty;
 
+    //  In a sequence, failures after a cut are committed: the enclosing
+    //  choice fails instead of trying its remaining alternatives.
+    struct Cut
+    {
+        QDPEG_CONSTEXPR20 Skipper operator()(Iter b,Iter ) const { return { b, Nothing{} }; }
+    };
+    static constexpr Cut cut {};
+
     inline Skipper eof(Iter b,Iter e)
     {
         return b == e
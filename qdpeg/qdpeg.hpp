@@ -1,14 +1,33 @@
 #pragma once
 #include <qdpeg/choice.hpp>
 #include <qdpeg/aux_parser.hpp>
+#include <qdpeg/char_class.hpp>
 #include <qdpeg/cpp20.hpp>
+#include <qdpeg/cst.hpp>
+#include <qdpeg/defer.hpp>
 #include <qdpeg/err_code.hpp>
+#include <qdpeg/format.hpp>
+#include <qdpeg/governor.hpp>
+#include <qdpeg/lexeme.hpp>
+#include <qdpeg/line_index.hpp>
+#include <qdpeg/literal_trie.hpp>
+#include <qdpeg/memo.hpp>
 #include <qdpeg/qdbase.hpp>
+#include <qdpeg/parse_binary.hpp>
 #include <qdpeg/parse_char.hpp>
+#include <qdpeg/parse_column.hpp>
 #include <qdpeg/parse_int.hpp>
+#include <qdpeg/parse_ip.hpp>
+#include <qdpeg/parse_time.hpp>
+#include <qdpeg/recover.hpp>
 #include <qdpeg/repeat.hpp>
+#include <qdpeg/repeat_array.hpp>
+#include <qdpeg/repeat_into.hpp>
+#include <qdpeg/scan.hpp>
 #include <qdpeg/seq.hpp>
 #include <qdpeg/strlit.hpp>
+#include <qdpeg/swar.hpp>
 #include <qdpeg/symbol.hpp>
+#include <qdpeg/token.hpp>
 #include <qdpeg/utility.hpp>
 #include <qdpeg/whitespace.hpp>
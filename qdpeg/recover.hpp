@@ -0,0 +1,120 @@
+#pragma once
+#include <qdpeg/char_class.hpp>
+#include <qdpeg/qdbase.hpp>
+#include <qdpeg/scan.hpp>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace qdpeg
+{
+    struct Parse_error
+    {
+        Iter        iter;
+        Error_code  error;
+    };
+
+    //  The errors recovered from during a parse. Only the first capacity
+    //  errors are kept, but all are counted.
+    class Error_log
+    {
+    public:
+        explicit Error_log(std::size_t capacity = 64)
+            : cap(capacity)
+        {}
+
+        void add(Iter i,Error_code ec)
+        {
+            if (errs.size() < cap)
+                errs.push_back({ i, ec });
+            ++total;
+        }
+
+        std::vector<Parse_error> const& errors() const noexcept { return errs; }
+        std::size_t count() const noexcept { return total; }
+        bool empty() const noexcept { return total == 0; }
+
+        void clear() noexcept
+        {
+            errs.clear();
+            total = 0;
+        }
+
+    private:
+        std::size_t                 cap;
+        std::size_t                 total = 0;
+        std::vector<Parse_error>    errs;
+    };
+
+    namespace details
+    {
+        //  On failure of p, log the error and continue after the sync
+        //  point found by find from the failure position. At the end of
+        //  input there is nothing to recover, so p's failure is returned
+        //  and an enclosing repeat stops.
+        template<class P,class Find>
+        auto make_recover(P p,Find find,Error_log& log)
+        {
+            static_assert(is_parser<P>(),"Only parsers can be recovered");
+            static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+            using result_type = std::conditional_t<is_skipper<P>(),
+                Nothing,
+                std::optional<Parsed_type<P>>>;
+
+            return [p,find,&log](Iter b,Iter e) -> Parse_result<result_type>
+            {
+                auto res = p(b,e);
+                if (res)
+                    return { res.iter, result_type { std::move(res.value()) } };
+                if (b == e)
+                    return { res.iter, res.error() };
+                log.add(res.iter,res.error());
+                return { find(b,res.iter,e), result_type {} };
+            };
+        }
+    }   //  namespace details
+
+    //  Parse p. If p fails, log the error and skip past the next sync
+    //  character, giving an empty optional.
+    template<class P>
+    auto recover(P p,char sync,Error_log& log)
+    {
+        return details::make_recover(std::move(p),[sync](Iter,Iter from,Iter e)
+        {
+            Iter pos = details::find_char(from,e,sync);
+            return pos == e ? e : pos + 1;
+        },log);
+    }
+
+    //  As above, skipping past the next character from sync
+    template<class P>
+    auto recover(P p,Char_class const& sync,Error_log& log)
+    {
+        return details::make_recover(std::move(p),[scanner = details::Class_scanner(~sync)](Iter,Iter from,Iter e)
+        {
+            Iter pos = scanner.skip_in(from,e);
+            return pos == e ? e : pos + 1;
+        },log);
+    }
+
+    //  As above, skipping past the next match of the sync parser, e.g. eol.
+    //  The sync parser is tried at each position, so prefer the overloads
+    //  for characters when possible.
+    template<class P,class Sync,
+        class = std::enable_if_t<is_parser<Sync>()>>
+    auto recover(P p,Sync sync,Error_log& log)
+    {
+        static_assert(is_const_parser<Sync>(),"Parsers must be callable as const");
+        return details::make_recover(std::move(p),[sync](Iter b,Iter from,Iter e)
+        {
+            for (Iter pos = from; pos != e; ++pos)
+            {
+                auto res = sync(pos,e);
+                if (res && res.iter != b)
+                    return res.iter;
+            }
+            return e;
+        },log);
+    }
+}   //  qdpeg
@@ -0,0 +1,56 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <array>
+#include <cstddef>
+
+namespace qdpeg::details
+{
+    //  Parse element I, keeping the already parsed elements in rs until all
+    //  N are present and the array can be constructed from them.
+    template<std::size_t I,std::size_t N,class P,class Skip,class... Rs>
+    auto build_array_n(Iter b,Iter e,P const& p,Skip const& ws [[maybe_unused]],Rs&... rs)
+        -> Parse_result<std::array<Parsed_type<P>,N>>
+    {
+        if constexpr (I == N)
+        {
+            return { b, std::array<Parsed_type<P>,N> { std::move(rs.value())... } };
+        }
+        else
+        {
+            if constexpr (I > 0 && !std::is_same_v<Skip,Empty_skipper>)
+            {
+                Skipper res = ws(b,e);
+                if (!res) return { res.iter, res.error(), res.committed };
+                b = res.iter;
+            }
+            auto res = p(b,e);
+            if (!res) return { res.iter, res.error(), res.committed };
+            return build_array_n<I + 1,N>(res.iter,e,p,ws,rs...,res);
+        }
+    }
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    //  Parse exactly N white space separated elements into a std::array
+    template<std::size_t N,class P,class Skip>
+    constexpr auto repeat(P p,Skip ws)
+    {
+        static_assert(N > 0,"repeat<N> requires at least one element");
+        static_assert(is_real_parser<P>(),"repeat<N> requires a real parser");
+        static_assert(is_skipper<Skip>(),"Second parameter must be a skipper");
+        static_assert(is_const_parser<P>() && is_const_parser<Skip>(),"Parsers must be callable as const");
+
+        return [p,ws](Iter b,Iter e)
+            -> Parse_result<std::array<Parsed_type<P>,N>>
+        {
+            return details::build_array_n<0,N>(b,e,p,ws);
+        };
+    }
+
+    template<std::size_t N,class P>
+    constexpr auto repeat(P p)
+    {
+        return repeat<N>(std::move(p),empty);
+    }
+}   //  namespace qdpeg
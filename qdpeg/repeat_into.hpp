@@ -0,0 +1,53 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <qdpeg/repeat.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace qdpeg::details
+{
+    //  An adder handing each element to a callable or an output iterator
+    //  instead of collecting it
+    template<class Sink>
+    struct Sink_adder
+    {
+        template<class T>
+        void add(T&& value)
+        {
+            if constexpr (std::is_invocable_v<Sink&,T&&>)
+            {
+                sink(std::forward<T>(value));
+            }
+            else
+            {
+                *sink = std::forward<T>(value);
+                ++sink;
+            }
+        }
+
+        Sink& sink;
+    };
+}   //  namespace qdpeg::details
+
+namespace qdpeg
+{
+    //  As repeat(p,args...), but each element is passed to sink as soon as
+    //  it is parsed instead of being stored, so memory use does not grow
+    //  with the number of elements. args are the optional skipper and
+    //  Length_checker of repeat. The sink is copied for each parse.
+    template<class P,class Sink,class... Args>
+    auto repeat_into(P p,Sink sink,Args... args)
+    {
+        static_assert(is_real_parser<P>(),"repeat_into requires a real parser");
+        auto rep = repeat(std::move(p),std::move(args)...);
+        static_assert(is_extended_parser<decltype(rep),details::Sink_adder<Sink>>,
+            "repeat does not accept an adder");
+
+        return [rep,sink](Iter b,Iter e) -> Skipper
+        {
+            Sink s = sink;
+            details::Sink_adder<Sink> adder { s };
+            return rep(b,e,adder);
+        };
+    }
+}   //  qdpeg
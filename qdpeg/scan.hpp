@@ -0,0 +1,151 @@
+#pragma once
+#include <qdpeg/char_class.hpp>
+#include <qdpeg/qdbase.hpp>
+#include <qdpeg/strlit.hpp>
+#include <qdpeg/whitespace.hpp>
+#include <cstring>
+
+namespace qdpeg
+{
+    //  What to do if the terminator is not found
+    enum class eof_policy
+    {
+        fail,       //  Fail with unexpected_eof
+        accept      //  Succeed, consuming the rest of the input
+    };
+
+    namespace details
+    {
+        //  True if the character at pos is preceded by an odd number of
+        //  escape characters after b
+        inline bool is_escaped(Iter b,Iter pos,char escape) noexcept
+        {
+            Iter p = pos;
+            while (p != b && *(p - 1) == escape)
+                --p;
+            return (pos - p) % 2 == 1;
+        }
+
+        //  First occurrence of ch in [b,e) or e
+        inline Iter find_char(Iter b,Iter e,char ch) noexcept
+        {
+            if (b == e)
+                return e;
+            auto first = &*b;
+            auto hit = static_cast<char const*>(
+                std::memchr(first,ch,static_cast<size_t>(e - b)));
+            return hit ? b + (hit - first) : e;
+        }
+
+        //  First occurrence of term in [b,e) or e
+        inline Iter find_string(Iter b,Iter e,std::string_view term) noexcept
+        {
+            if (term.empty())
+                return b;
+            auto const len = cpp20::ssize(term);
+            for (Iter p = b;;)
+            {
+                p = find_char(p,e,term[0]);
+                if (e - p < len)
+                    return e;
+                if (std::memcmp(&*p,term.data(),term.size()) == 0)
+                    return p;
+                ++p;
+            }
+        }
+
+        template<class Find>
+        auto find_unescaped(Iter b,Iter e,char escape,Find find) -> Iter
+        {
+            for (Iter p = b;;)
+            {
+                p = find(p,e);
+                if (p == e || !is_escaped(b,p,escape))
+                    return p;
+                ++p;
+            }
+        }
+
+        template<class Find>
+        auto make_scanner(eof_policy ep,Find find)
+        {
+            return [ep,find](Iter b,Iter e) -> Parse_result<Raw>
+            {
+                Iter pos = find(b,e);
+                if (pos == e && ep == eof_policy::fail)
+                    return { e, Error_code::unexpected_eof };
+                return { pos, make_raw(b,pos) };
+            };
+        }
+    }   //  namespace details
+
+    //  Parse the text up to, but not including, the terminator
+    inline auto scan_until(char term,eof_policy ep = eof_policy::fail)
+    {
+        return details::make_scanner(ep,[term](Iter b,Iter e)
+        {
+            return details::find_char(b,e,term);
+        });
+    }
+
+    //  As above, skipping terminators preceded by an escape character
+    inline auto scan_until(char term,char escape,eof_policy ep = eof_policy::fail)
+    {
+        return details::make_scanner(ep,[term,escape](Iter b,Iter e)
+        {
+            return details::find_unescaped(b,e,escape,[term](Iter pb,Iter pe)
+            {
+                return details::find_char(pb,pe,term);
+            });
+        });
+    }
+
+    inline auto scan_until(str_lit term,eof_policy ep = eof_policy::fail)
+    {
+        return details::make_scanner(ep,[term](Iter b,Iter e)
+        {
+            return details::find_string(b,e,term);
+        });
+    }
+
+    inline auto scan_until(str_lit term,char escape,eof_policy ep = eof_policy::fail)
+    {
+        return details::make_scanner(ep,[term,escape](Iter b,Iter e)
+        {
+            return details::find_unescaped(b,e,escape,[term](Iter pb,Iter pe)
+            {
+                return details::find_string(pb,pe,term);
+            });
+        });
+    }
+
+    //  Parse the text up to the first character in terms
+    inline auto scan_until(Char_class const& terms,eof_policy ep = eof_policy::fail)
+    {
+        return details::make_scanner(ep,[scanner = details::Class_scanner(~terms)](Iter b,Iter e)
+        {
+            return scanner.skip_in(b,e);
+        });
+    }
+
+    //  Parse the text up to the first of Chars
+    template<char... Chars>
+    auto scan_until_any(eof_policy ep = eof_policy::fail)
+    {
+        static_assert(sizeof...(Chars) > 0,"scan_until_any requires a terminator");
+        return scan_until(char_class_of<Chars...>,ep);
+    }
+
+    //  As scan_until, but as a skipper
+    template<class... Args>
+    auto skip_until(Args... args)
+    {
+        return skip(scan_until(args...));
+    }
+
+    template<char... Chars>
+    auto skip_until_any(eof_policy ep = eof_policy::fail)
+    {
+        return skip(scan_until_any<Chars...>(ep));
+    }
+}   //  qdpeg
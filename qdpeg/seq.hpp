@@ -26,25 +26,22 @@ namespace qdpeg::details
         : is_brace_constructible<T, Args...>
     {};
 
-    template<class Result, class ParseResTup, size_t ... I>
-    Result make_braced(ParseResTup& tup, std::index_sequence<I...>)
-    {
-        return Result{ std::move(std::get<I>(tup).value())... };
-    }
-    template<class Result, class ParseResTup>
-    Result make_braced(ParseResTup& tup)
-    {
-        using idx_seq = std::make_index_sequence<std::tuple_size_v<ParseResTup>>;
-        return make_braced<Result> (tup, idx_seq{});
-    }
-
     using namespace boost::mp11;
+
+    //  The skipper runs before each element but the first. A cut is not
+    //  separated from the element before it, so the skipper following a
+    //  cut is committed by it, in all the builders alike.
+    template <size_t I, class Skip, class ParseTup>
+    constexpr bool skip_before = I > 0
+        && !std::is_same_v<Skip, decltype(empty)>
+        && !std::is_same_v<std::tuple_element_t<I, ParseTup>, Cut>;
+
     template <size_t I, class Adder, class Skip, class ParseTup>
-    Skipper build_array_x(Iter b,
+    constexpr Skipper build_array_x(Iter b,
         Iter e [[maybe_unused]] ,
         Adder& a,
-        Skip& skip [[maybe_unused]] ,
-        ParseTup& ptup [[maybe_unused]] )
+        Skip const& skip [[maybe_unused]] ,
+        ParseTup const& ptup [[maybe_unused]] )
     {
         if constexpr (I == std::tuple_size_v<ParseTup>)
         {
@@ -52,7 +49,7 @@ namespace qdpeg::details
         }
         else
         {
-            if constexpr (I > 0 && !std::is_same_v<Skip, decltype(empty)>)
+            if constexpr (skip_before<I, Skip, ParseTup>)
             {
                 Skipper res = skip(b, e);
                 if (!res) return res;
@@ -70,31 +67,40 @@ namespace qdpeg::details
                 if constexpr (is_extended_parser<Parser, Adder>)
                 {
                     auto res = std::get<I>(ptup)(b, e, a);
-                    if (!res) return { res.iter, res.error() };
+                    if (!res) return { res.iter, res.error(), res.committed };
                     b = res.iter;
                 }
                 else
                 {
                     auto res = std::get<I>(ptup)(b, e);
-                    if (!res) return { res.iter, res.error() };
+                    if (!res) return { res.iter, res.error(), res.committed };
 
-                    if constexpr (I == 0) a.add(std::move(res.value()));
+                    a.add(std::move(res.value()));
 
                     b = res.iter;
                 }
             }
-            return build_array_x<I + 1>(b, e, a, skip, ptup);
+            if constexpr (std::is_same_v<Parser, Cut>)
+            {
+                auto res = build_array_x<I + 1>(b, e, a, skip, ptup);
+                if (!res) res.committed = true;
+                return res;
+            }
+            else
+            {
+                return build_array_x<I + 1>(b, e, a, skip, ptup);
+            }
         }
     }
 
     template<class RetType, class Skip, class... Ps>
     struct seq_to_array
     {
-        seq_to_array(Skip& s, Ps& ... ps)
+        constexpr seq_to_array(Skip& s, Ps& ... ps)
             : skip(std::move(s))
             , tup_parse(std::move(ps)...)
         {}
-        auto operator()(Iter b, Iter e) -> Parse_result<RetType>
+        constexpr auto operator()(Iter b, Iter e) const -> Parse_result<RetType>
         {
             using Adder = details::element_adder<RetType>;
 
@@ -104,17 +110,17 @@ namespace qdpeg::details
             {
                 return { res.iter, adder.return_value() };
             }
-            return { res.iter, res.error() };
+            return { res.iter, res.error(), res.committed };
         }
         Skip                skip;
         std::tuple<Ps...>   tup_parse;
     };
 
     template <size_t I, class Skip, class ParseTup>
-    auto build_skip_tup(Iter b,
+    constexpr auto build_skip_tup(Iter b,
         Iter e [[maybe_unused]] ,
-        Skip& skip [[maybe_unused]] ,
-        ParseTup& ptup [[maybe_unused]] ) -> Skipper
+        Skip const& skip [[maybe_unused]] ,
+        ParseTup const& ptup [[maybe_unused]] ) -> Skipper
 
     {
         //if constexpr (true) { return {b}; } else
@@ -124,92 +130,87 @@ namespace qdpeg::details
         }
         else
         {
+            if constexpr (skip_before<I, Skip, ParseTup>)
+            {
+                Skipper res = skip(b, e);
+                if (!res) return res;
+                b = res.iter;
+            }
             auto res = std::get<I>(ptup)(b,e);
             if (!res) return res;
-            if constexpr (I + 1 < std::tuple_size_v<ParseTup>)
+            if constexpr (std::is_same_v<std::tuple_element_t<I, ParseTup>, Cut>)
             {
-                res = skip(res.iter,e);
-                if (!res) return res;
+                res = build_skip_tup<I + 1>(res.iter,e,skip,ptup);
+                if (!res) res.committed = true;
+                return res;
+            }
+            else
+            {
+                return build_skip_tup<I + 1>(res.iter,e,skip,ptup);
             }
-            return build_skip_tup<I + 1>(res.iter,e,skip,ptup);
         }
     }
 
-    template <size_t I, size_t R, class Result, class Skip, class ParseTup>
-    Skipper build_tup_x(Iter b,
+    //  Parse element I of the sequence. The results of the real parsers
+    //  seen so far are kept in rs and moved once, directly into the
+    //  RetType constructed inside the final Parse_result.
+    template <size_t I, class RetType, class Skip, class ParseTup, class... Rs>
+    constexpr auto build_tup_x(Iter b,
         Iter e [[maybe_unused]] ,
-        Result & r [[maybe_unused]] ,
-        Skip & skip [[maybe_unused]] ,
-        ParseTup& ptup [[maybe_unused]] )
+        Skip const& skip [[maybe_unused]] ,
+        ParseTup const& ptup [[maybe_unused]] ,
+        Rs&... rs) -> Parse_result<RetType>
     {
         if constexpr (I == std::tuple_size_v<ParseTup>)
         {
-            return b;
+            return { b, std::in_place, std::move(rs.value())... };
         }
         else
         {
             using Parser = std::tuple_element_t<I, ParseTup>;
             auto& p = std::get<I>(ptup);
 
-            if constexpr (I > 0 && !std::is_same_v<Skip, decltype(empty)>)
+            if constexpr (skip_before<I, Skip, ParseTup>)
             {
                 Skipper res = skip(b, e);
-                if (!res) return res;
+                if (!res) return { res.iter, res.error(), res.committed };
                 b = res.iter;
             }
             if constexpr (is_skipper<Parser>())
             {
                 auto res = p(b, e);
-                if (!res) return res;
-                return build_tup_x<I + 1, R>(res.iter, e, r, skip, ptup);
+                if (!res) return { res.iter, res.error(), res.committed };
+                if constexpr (std::is_same_v<Parser, Cut>)
+                {
+                    auto rest = build_tup_x<I + 1, RetType>(res.iter, e, skip, ptup, rs...);
+                    if (!rest) rest.committed = true;
+                    return rest;
+                }
+                else
+                {
+                    return build_tup_x<I + 1, RetType>(res.iter, e, skip, ptup, rs...);
+                }
             }
             else
             {
-                std::get<R>(r) = p(b, e);
-
-                if (!std::get<R>(r)) return { std::get<R>(r).iter, std::get<R>(r).error() };
-
-                return build_tup_x<I + 1, R + 1>(std::get<R>(r).iter, e, r, skip, ptup);
+                auto res = p(b, e);
+                if (!res) return { res.iter, res.error(), res.committed };
+                return build_tup_x<I + 1, RetType>(res.iter, e, skip, ptup, rs..., res);
             }
         }
-    };
-
-    template<class RawResult, class Skip, class ParseTup>
-    auto build_tup(Iter b,
-        Iter e,
-        Skip & skip,
-        ParseTup& ptup)
-    {
-        Skipper dummy;
-        Parse_result<char> data;
-        RawResult  rresult;
-        std::pair<Skipper, RawResult> result;
-        result.first = build_tup_x<0, 0>(b, e, result.second, skip, ptup);
-        return result;
     }
 
     template<class RetType, class Skip, class... Ps>
     struct seq_to_tuple
     {
-        using real_parsers = mp_remove_if<std::tuple<Ps...>, is_skipper_t>;
-        using parse_results = mp_transform<Parsed_return, real_parsers>;
-
-        seq_to_tuple(Skip& s, Ps& ... ps)
+        constexpr seq_to_tuple(Skip& s, Ps& ... ps)
             : skip(std::move(s))
             , tup_parse(std::move(ps)...)
         {}
 
-        auto operator()(Iter b, Iter e) -> Parse_result<RetType>
+        constexpr auto operator()(Iter b, Iter e) const -> Parse_result<RetType>
         {
-            auto raw_result = build_tup<parse_results>(b, e, skip, tup_parse);
-            if (!raw_result.first)
-            {
-                return { raw_result.first.iter, raw_result.first.error() };
-            }
-            return {
-                raw_result.first.iter,
-                details::make_braced<RetType>(raw_result.second)
-            };
+            return build_tup_x<0, RetType>(b, e, skip, tup_parse);
         }
     private:
         Skip                skip;
@@ -226,7 +227,7 @@ namespace qdpeg::details
         using std_type  = container_for<result_elem>;
 
         template <class Ret, class Skip, class... Ps>
-        static auto typed_parse(Skip& s, Ps& ... ps)
+        static constexpr auto typed_parse(Skip& s, Ps& ... ps)
         {
             if constexpr (is_brace_constructible_from_tup<Ret, std_tuple>())
             {
@@ -238,10 +239,15 @@ namespace qdpeg::details
             }
         }
 
+        //  Brace initialising the container goes through an
+        //  initializer_list, which copies, so move-only elements are added
         template <class Skip, class... Ps>
-        static auto untyped_parse(Skip& s, Ps& ... ps)
+        static constexpr auto untyped_parse(Skip& s, Ps& ... ps)
         {
-            return typed_parse<std_type>(s, ps...);
+            if constexpr (std::is_copy_constructible_v<result_elem>)
+                return typed_parse<std_type>(s, ps...);
+            else
+                return seq_to_array<std_type, Skip, Ps...> { s, ps... };
         }
     };  //  seq_cat_same
 
@@ -249,39 +255,21 @@ namespace qdpeg::details
     template<class RPList>
     struct seq_cat_same<1, RPList>
     {
-        using parsed_result = Parsed_return<mp_first<RPList>>;
-        using std_result = typename parsed_result::result_type;
+        using std_result = Parsed_type<mp_first<RPList>>;
 
         template <class Result, class Skip, class... Ps>
-        static auto typed_parse(Skip& s, Ps& ... ps)
+        static constexpr auto typed_parse(Skip& s, Ps& ... ps)
         {
             return[skip = std::move(s), 
-                tup_parse = std::tuple{ std::move(ps)... }] (Iter b, Iter e) mutable 
+                tup_parse = std::tuple{ std::move(ps)... }] (Iter b, Iter e)
                 ->Parse_result<Result>
             {
-                auto raw_result = build_tup<std::tuple<parsed_result>>(b, e, skip, tup_parse);
-                if (raw_result.first)
-                {
-                    if constexpr (std::is_same_v<Result, std_result>)
-                    {
-                        std::get<0>(raw_result.second).iter = raw_result.first.iter;
-                        return std::move(std::get<0>(raw_result.second));
-                    }
-                    else
-                    {
-                        return
-                        {
-                            raw_result.first.iter,
-                            Result{ std::get<0>(raw_result.second).value() }
-                        };
-                    }
-                }
-                return { raw_result.first.iter, raw_result.first.error() };
+                return build_tup_x<0, Result>(b, e, skip, tup_parse);
             };
         }
 
         template <class Skip, class... Ps>
-        static auto untyped_parse(Skip& s, Ps& ... ps)
+        static constexpr auto untyped_parse(Skip& s, Ps& ... ps)
         {
             return typed_parse<std_result>(s, ps...);
         }
@@ -292,12 +280,12 @@ namespace qdpeg::details
     {
         using std_result = mp_rename<mp_transform<Parsed_type, RPList>, std::tuple>;
         template <class Skip, class... Ps>
-        static auto untyped_parse(Skip& s, Ps& ... ps)
+        static constexpr auto untyped_parse(Skip& s, Ps& ... ps)
         {
             return seq_to_tuple<std_result, Skip, Ps...> { s, ps... };
         }
         template <class Ret, class Skip, class... Ps>
-        static auto typed_parse(Skip& s, Ps& ... ps)
+        static constexpr auto typed_parse(Skip& s, Ps& ... ps)
         {
             return seq_to_tuple<Ret, Skip, Ps...> { s, ps... };
         }
@@ -311,15 +299,15 @@ namespace qdpeg::details
         static_assert(real_ps == 0);
 
         template <class Skip, class... Ps>
-        static auto untyped_parse(Skip& s, Ps& ... ps)
+        static constexpr auto untyped_parse(Skip& s, Ps& ... ps)
         {
-            return[skip = std::move(s), tup_parse = std::tuple{ std::move(ps)... }](Iter b, Iter e) mutable
+            return[skip = std::move(s), tup_parse = std::tuple{ std::move(ps)... }](Iter b, Iter e)
             {
                 return build_skip_tup<0>(b, e, skip, tup_parse);
             };
         }
         template <class Ret, class Skip, class... Ps>
-        static auto typed_parse(Skip&, Ps& ... ps)
+        static constexpr auto typed_parse(Skip&, Ps& ... ps)
         {
             static_assert(sizeof...(ps) < 0, "Parser only contains skippers. To force a type use emit");
         }
@@ -335,10 +323,11 @@ namespace qdpeg::details
 namespace qdpeg
 {
     template<class Skip, class... Ps>
-    auto seq_ws(Skip s, Ps... ps)
+    constexpr auto seq_ws(Skip s, Ps... ps)
     {
         static_assert(is_skipper<Skip>(), "First parameter must be a skipper");
         static_assert(all_parsers<Ps...>(), "Non-parser passed as argument");
+        static_assert((is_const_parser<Skip>() && ... && is_const_parser<Ps>()), "Parsers must be callable as const");
 
         //  Remove all skippers 
         using real_parsers = mp_remove_if<mp_list<Ps...>, is_skipper_t>;
@@ -355,10 +344,11 @@ namespace qdpeg
     }   // seq_ws
 
     template<class RetType, class Skip, class... Ps>
-    auto seq_ws(Skip s, Ps... ps)
+    constexpr auto seq_ws(Skip s, Ps... ps)
     {
         static_assert(is_skipper<Skip>(), "First parameter must be a skipper");
         static_assert(all_parsers<Ps...>(), "Non-parser passed as argument");
+        static_assert((is_const_parser<Skip>() && ... && is_const_parser<Ps>()), "Parsers must be callable as const");
 
         //  Remove all skippers 
         using real_parsers = mp_remove_if<mp_list<Ps...>, is_skipper_t>;
@@ -375,14 +365,14 @@ namespace qdpeg
     }   // seq_ws
 
     template<class... Ps>
-    auto seq(Ps... ps)
+    constexpr auto seq(Ps... ps)
     {
         static_assert(all_parsers<Ps...>(), "Non-parser passed as argument");
         return seq_ws(empty, std::move(ps)...);
     }
 
     template<class RetType, class... Ps>
-    auto seq(Ps... ps)
+    constexpr auto seq(Ps... ps)
     {
         return seq_ws<RetType>(empty, std::move(ps)...);
     }
@@ -1,4 +1,5 @@
 #pragma once
+#include <qdpeg/cpp20.hpp>
 #include <algorithm>
 #include <array>
 #include <cstring>
@@ -53,26 +54,26 @@ struct ci_strlit
     {}
     using base::begin;
     using base::end;
-    bool lt(std::string_view rhs) const noexcept 
+    QDPEG_CONSTEXPR20 bool lt(std::string_view rhs) const noexcept 
     { 
         return std::lexicographical_compare(begin(),end(),rhs.begin(),rhs.end(),ic_less);
     }
-    bool gt(std::string_view rhs) const noexcept 
+    QDPEG_CONSTEXPR20 bool gt(std::string_view rhs) const noexcept 
     { 
         return std::lexicographical_compare(rhs.begin(),rhs.end(),begin(),end(),ic_less);
     }
-    bool eq(std::string_view rhs) const noexcept 
+    QDPEG_CONSTEXPR20 bool eq(std::string_view rhs) const noexcept 
     { 
         return std::equal(rhs.begin(),rhs.end(),begin(),end(),ic_eq);
     }
 };
 
-inline bool operator < (str_lit const& sl,str_lit const& o) { return std::string_view(sl) <  o; }
-inline bool operator >=(str_lit const& sl,str_lit const& o) { return std::string_view(sl) >= o; }
-inline bool operator ==(str_lit const& sl,str_lit const& o) { return std::string_view(sl) == o; }
-inline bool operator !=(str_lit const& sl,str_lit const& o) { return std::string_view(sl) != o; }
-inline bool operator > (str_lit const& sl,str_lit const& o) { return std::string_view(sl) >  o; }
-inline bool operator <=(str_lit const& sl,str_lit const& o) { return std::string_view(sl) <= o; }
+constexpr bool operator < (str_lit const& sl,str_lit const& o) { return std::string_view(sl) <  o; }
+constexpr bool operator >=(str_lit const& sl,str_lit const& o) { return std::string_view(sl) >= o; }
+constexpr bool operator ==(str_lit const& sl,str_lit const& o) { return std::string_view(sl) == o; }
+constexpr bool operator !=(str_lit const& sl,str_lit const& o) { return std::string_view(sl) != o; }
+constexpr bool operator > (str_lit const& sl,str_lit const& o) { return std::string_view(sl) >  o; }
+constexpr bool operator <=(str_lit const& sl,str_lit const& o) { return std::string_view(sl) <= o; }
 
 template<class O> constexpr std::enable_if_t<!std::is_same_v<O,ci_strlit>,bool> operator < (str_lit const& sl,O const& o) { return std::string_view(sl) <  o; }
 template<class O> constexpr std::enable_if_t<!std::is_same_v<O,ci_strlit>,bool> operator >=(str_lit const& sl,O const& o) { return std::string_view(sl) >= o; }
@@ -88,12 +89,12 @@ template<class O> constexpr std::enable_if_t<!std::is_same_v<O,ci_strlit>,bool>
 template<class O> constexpr std::enable_if_t<!std::is_same_v<O,ci_strlit>,bool> operator > (O const& o,str_lit const& sl) { return o >  std::string_view(sl); }
 template<class O> constexpr std::enable_if_t<!std::is_same_v<O,ci_strlit>,bool> operator <=(O const& o,str_lit const& sl) { return o <= std::string_view(sl); }
 
-inline bool operator < (ci_strlit const& sl,ci_strlit const& o) { return sl.lt(o); }
-inline bool operator >=(ci_strlit const& sl,ci_strlit const& o) { return !sl.lt(o); }
-inline bool operator ==(ci_strlit const& sl,ci_strlit const& o) { return sl.eq(o); }
-inline bool operator !=(ci_strlit const& sl,ci_strlit const& o) { return !sl.eq(o); }
-inline bool operator > (ci_strlit const& sl,ci_strlit const& o) { return sl.gt(o); }
-inline bool operator <=(ci_strlit const& sl,ci_strlit const& o) { return !sl.gt(o); }
+QDPEG_CONSTEXPR20 bool operator < (ci_strlit const& sl,ci_strlit const& o) { return sl.lt(o); }
+QDPEG_CONSTEXPR20 bool operator >=(ci_strlit const& sl,ci_strlit const& o) { return !sl.lt(o); }
+QDPEG_CONSTEXPR20 bool operator ==(ci_strlit const& sl,ci_strlit const& o) { return sl.eq(o); }
+QDPEG_CONSTEXPR20 bool operator !=(ci_strlit const& sl,ci_strlit const& o) { return !sl.eq(o); }
+QDPEG_CONSTEXPR20 bool operator > (ci_strlit const& sl,ci_strlit const& o) { return sl.gt(o); }
+QDPEG_CONSTEXPR20 bool operator <=(ci_strlit const& sl,ci_strlit const& o) { return !sl.gt(o); }
 
 template<class O> constexpr bool operator < (ci_strlit const& sl,O const& o) { return sl.lt(o); }
 template<class O> constexpr bool operator >=(ci_strlit const& sl,O const& o) { return !sl.lt(o); }
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//  SIMD within a register: helpers treating a 64-bit word as eight
+//  characters. Lane 0 is the first character regardless of byte order.
+namespace qdpeg::details
+{
+    inline constexpr std::uint64_t swar_ones = 0x0101010101010101ULL;
+    inline constexpr std::uint64_t swar_high = 0x8080808080808080ULL;
+
+    //  The eight characters at p as a word
+    inline std::uint64_t swar_load(char const* p) noexcept
+    {
+        std::uint64_t v;
+        std::memcpy(&v,p,sizeof v);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        v = __builtin_bswap64(v);
+#endif
+        return v;
+    }
+
+    //  The high bit set in each lane equal to ch
+    constexpr std::uint64_t swar_eq(std::uint64_t v,char ch) noexcept
+    {
+        std::uint64_t x = v ^ (swar_ones * static_cast<unsigned char>(ch));
+        return ~(((x & ~swar_high) + ~swar_high) | x) & swar_high;
+    }
+
+    //  The high bit set in each lane holding a decimal digit
+    constexpr std::uint64_t swar_digits(std::uint64_t v) noexcept
+    {
+        std::uint64_t x = v & ~swar_high;
+        std::uint64_t ge0 = (x + swar_ones * (0x80 - '0')) & swar_high;
+        std::uint64_t gt9 = (x + swar_ones * (0x80 - '9' - 1)) & swar_high;
+        return ge0 & ~gt9 & ~v;
+    }
+
+    //  The number of zero bits below the lowest set bit of v, which must
+    //  not be 0
+    inline int count_trailing_zeros(std::uint32_t v) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index,v);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(v);
+#endif
+    }
+
+    //  Gather the high bits of the lanes into a byte, lane i to bit i
+    constexpr unsigned swar_bits(std::uint64_t mask) noexcept
+    {
+        return static_cast<unsigned>(((mask >> 7) * 0x0102040810204080ULL) >> 56);
+    }
+
+    //  A fixed layout of eight characters: 'd' is a digit, '_' is any
+    //  character and everything else must match exactly.
+    struct Swar_layout
+    {
+        std::uint64_t   digits = 0;
+        std::uint64_t   fixed = 0;
+        std::uint64_t   chars = 0;
+    };
+
+    constexpr Swar_layout swar_layout(char const (&layout)[9]) noexcept
+    {
+        Swar_layout res;
+        for (int i = 0; i < 8; ++i)
+        {
+            auto const lane = std::uint64_t(0xff) << (8 * i);
+            if (layout[i] == 'd')
+                res.digits |= lane & swar_high;
+            else if (layout[i] != '_')
+            {
+                res.fixed |= lane;
+                res.chars |= std::uint64_t(static_cast<unsigned char>(layout[i])) << (8 * i);
+            }
+        }
+        return res;
+    }
+
+    constexpr bool swar_match(std::uint64_t v,Swar_layout const& layout) noexcept
+    {
+        return ((v ^ layout.chars) & layout.fixed) == 0
+            && (swar_digits(v) & layout.digits) == layout.digits;
+    }
+
+    //  The value of the two digits starting at lane
+    constexpr unsigned swar_2digits(std::uint64_t v,int lane) noexcept
+    {
+        v >>= 8 * lane;
+        return static_cast<unsigned>((v & 0x0f) * 10 + ((v >> 8) & 0x0f));
+    }
+
+    //  The value of the four digits starting at lane
+    constexpr unsigned swar_4digits(std::uint64_t v,int lane) noexcept
+    {
+        v = (v >> (8 * lane)) & 0x0f0f0f0f;
+        v = (v * 10 + (v >> 8)) & 0x00ff00ff;
+        return static_cast<unsigned>((v * 100 + (v >> 16)) & 0xffff);
+    }
+
+    //  The value of eight digits
+    constexpr std::uint32_t swar_8digits(std::uint64_t v) noexcept
+    {
+        v &= 0x0f0f0f0f0f0f0f0fULL;
+        v = (v * 10 + (v >> 8)) & 0x00ff00ff00ff00ffULL;
+        v = (v * 100 + (v >> 16)) & 0x0000ffff0000ffffULL;
+        return static_cast<std::uint32_t>((v * 10000 + (v >> 32)) & 0xffffffff);
+    }
+}   //  namespace qdpeg::details
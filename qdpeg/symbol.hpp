@@ -10,19 +10,19 @@ namespace qdpeg
         template<class K,class V>
         struct Symbol_element
         {
-            friend bool operator<(
+            friend constexpr bool operator<(
                 Symbol_element const& lhs,
                 std::string_view rhs)
             {
                 return lhs.name < rhs;
             }
-            friend bool operator<(
+            friend constexpr bool operator<(
                 std::string_view lhs,
                 Symbol_element const& rhs)
             {
                 return lhs < rhs.name;
             }
-            bool operator<(Symbol_element const& rhs) const
+            constexpr bool operator<(Symbol_element const& rhs) const
             {
                 return name < rhs;
             }
@@ -45,7 +45,7 @@ namespace qdpeg
             using Siter = typename std::vector<Symbol_element<K,V>>::const_iterator;
             using Rng = std::pair<Siter,Siter>;
 
-            Symbol_x(std::initializer_list<Symbol_element<K,V>>  elements)
+            QDPEG_CONSTEXPR20 Symbol_x(std::initializer_list<Symbol_element<K,V>>  elements)
                 : sv(elements)
             {
                 std::sort(sv.begin(),sv.end(),[](auto& a,auto& b)
@@ -54,7 +54,7 @@ namespace qdpeg
                 });
             }
 
-            auto operator()(Iter b,Iter e) const -> Parse_result<V>
+            QDPEG_CONSTEXPR20 auto operator()(Iter b,Iter e) const -> Parse_result<V>
             {
                 auto res = find_elem(b,e);
                 if (res == sv.end())
@@ -66,8 +66,19 @@ namespace qdpeg
                     return { b + cpp20::ssize(res->name), res->value };
                 }
             }
+
+            //  The first name, in sort order, having the value v, or
+            //  nullptr if there is none
+            QDPEG_CONSTEXPR20 auto name_of(V const& v) const -> K const*
+            {
+                auto res = std::find_if(sv.begin(),sv.end(),[&v](auto const& elem)
+                {
+                    return elem.value == v;
+                });
+                return res == sv.end() ? nullptr : &res->name;
+            }
         private:
-            auto find_elem(Iter b,Iter e) const
+            QDPEG_CONSTEXPR20 auto find_elem(Iter b,Iter e) const
             {
                 Siter end = sv.end(); 
                 if (b == e) 
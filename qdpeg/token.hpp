@@ -0,0 +1,398 @@
+#pragma once
+#include <qdpeg/qdbase.hpp>
+#include <boost/mp11.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace qdpeg
+{
+    //  A token of the input: its kind and where its text is, relative to
+    //  the start of the tokenized text
+    struct Token
+    {
+        std::int32_t    kind;
+        std::uint32_t   offset;
+        std::uint32_t   length;
+    };
+
+    //  A position in a token array, knowing the text the tokens refer to
+    struct Token_iter
+    {
+        Token const*    tok;
+        Iter            text;
+
+        Token const& operator*() const noexcept { return *tok; }
+        Token const* operator->() const noexcept { return tok; }
+        Token_iter& operator++() noexcept { ++tok; return *this; }
+
+        //  The text of the token
+        Raw str() const { return make_raw(text + tok->offset,text + tok->offset + tok->length); }
+
+        friend bool operator==(Token_iter a,Token_iter b) noexcept { return a.tok == b.tok; }
+        friend bool operator!=(Token_iter a,Token_iter b) noexcept { return a.tok != b.tok; }
+        friend bool operator< (Token_iter a,Token_iter b) noexcept { return a.tok <  b.tok; }
+        friend bool operator> (Token_iter a,Token_iter b) noexcept { return a.tok >  b.tok; }
+        friend std::ptrdiff_t operator-(Token_iter a,Token_iter b) noexcept { return a.tok - b.tok; }
+        friend Token_iter operator+(Token_iter a,std::ptrdiff_t n) noexcept { return { a.tok + n, a.text }; }
+    };
+
+    //  The tokens of a text
+    class Tokens
+    {
+    public:
+        Tokens(Raw text,std::vector<Token> tokens)
+            : txt(text)
+            , toks(std::move(tokens))
+        {}
+
+        Raw text() const noexcept { return txt; }
+        std::vector<Token> const& tokens() const noexcept { return toks; }
+        Token_iter begin() const noexcept { return { toks.data(), txt.begin() }; }
+        Token_iter end() const noexcept { return { toks.data() + toks.size(), txt.begin() }; }
+
+        //  The position in the text of the token at i, the end of the text
+        //  at the end of the tokens
+        Iter position(Token_iter i) const noexcept
+        {
+            return i == end() ? txt.end() : txt.begin() + i->offset;
+        }
+
+    private:
+        Raw                 txt;
+        std::vector<Token>  toks;
+    };
+
+    //  The result of a parser over tokens: as Parse_result, but positioned
+    //  in the tokens
+    template<class T>
+    struct Token_result
+    {
+        using result_type = T;
+
+        Token_result(Token_iter i,T v)
+            : iter(i)
+            , val(std::move(v))
+        {}
+        Token_result(Token_iter i,Error_code ec)
+            : iter(i)
+            , ec(ec)
+        {}
+
+        operator bool() const noexcept { return val.has_value(); }
+        bool operator!() const noexcept { return !val.has_value(); }
+        Error_code error() const noexcept { return ec; }
+        T const& value() const { if (!val) bad_parse_access(); return *val; }
+        T& value() { if (!val) bad_parse_access(); return *val; }
+
+        Token_iter          iter;
+        std::optional<T>    val;
+        Error_code          ec = Error_code::no_error;
+    };
+
+    namespace details
+    {
+        template<class P>
+        using token_value = typename decltype(std::declval<P const&>()(
+            std::declval<Token_iter>(),std::declval<Token_iter>()))::result_type;
+
+        template<class P>
+        struct Token_rule
+        {
+            std::int32_t    kind;
+            P               p;
+        };
+
+        //  The values of a sequence of token parsers, leaving out the
+        //  Nothings: Nothing, a single value or a tuple
+        template<class Vals,class... Is>
+        auto token_collect(Vals& vals [[maybe_unused]],boost::mp11::mp_list<Is...>)
+        {
+            if constexpr (sizeof...(Is) == 0)
+                return Nothing {};
+            else if constexpr (sizeof...(Is) == 1)
+                return std::move(*std::get<Is::value...>(vals));
+            else
+                return std::tuple<typename std::tuple_element_t<Is::value,Vals>::value_type...> {
+                    std::move(*std::get<Is::value>(vals))... };
+        }
+    }   //  namespace details
+
+    //  A token of the given kind parsed by p, which must be const callable
+    template<class P>
+    auto token(std::int32_t kind,P p)
+    {
+        static_assert(is_parser<P>(),"Tokens are parsed by parsers");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+        return details::Token_rule<P> { kind, std::move(p) };
+    }
+
+    //  A parser splitting its input into tokens. ws is skipped before each
+    //  token and is not part of any token. At each position the rule with
+    //  the longest match gives the token, the first given on a tie, so
+    //  keywords should be given before identifiers. Fails where ws is
+    //  followed by input no rule matches.
+    template<class Skip,class... Rules>
+    auto lexer(Skip ws,Rules... rules)
+    {
+        static_assert(is_skipper<Skip>(),"First parameter must be a skipper");
+        static_assert(is_const_parser<Skip>(),"Parsers must be callable as const");
+        static_assert(sizeof...(Rules) > 0,"A lexer requires at least one token rule");
+
+        return [ws,rules = std::tuple(rules...)](Iter b,Iter e) -> Parse_result<Tokens>
+        {
+            std::vector<Token> toks;
+            Iter pos = b;
+            for (;;)
+            {
+                Skipper sk = ws(pos,e);
+                if (!sk)
+                    return { sk.iter, sk.error() };
+                pos = sk.iter;
+                if (pos == e)
+                    break;
+
+                std::int32_t kind = 0;
+                Iter best = pos;
+                Iter fail = pos;
+                std::apply([&](auto const&... rule)
+                {
+                    auto try_rule = [&](auto const& r)
+                    {
+                        auto res = r.p(pos,e);
+                        if (res && res.iter > best)
+                        {
+                            best = res.iter;
+                            kind = r.kind;
+                        }
+                        else if (!res && res.iter > fail)
+                        {
+                            fail = res.iter;
+                        }
+                    };
+                    (try_rule(rule),...);
+                },rules);
+                if (best == pos)
+                    return { fail, fail == e ? Error_code::unexpected_eof : Error_code::unexpected_char };
+                toks.push_back({ kind,
+                    static_cast<std::uint32_t>(pos - b),
+                    static_cast<std::uint32_t>(best - pos) });
+                pos = best;
+            }
+            return { e, Tokens { make_raw(b,e), std::move(toks) } };
+        };
+    }
+}   //  qdpeg
+
+//  Parsers over tokens, mirroring the parsers over characters. Skipping
+//  white space and matching the characters of a token is done once, by the
+//  lexer, however often the grammar backtracks.
+namespace qdpeg::tok
+{
+    //  A token of kind k, as its text
+    inline auto kind(std::int32_t k)
+    {
+        return [k](Token_iter b,Token_iter e) -> Token_result<Raw>
+        {
+            if (b == e)
+                return { b, Error_code::unexpected_eof };
+            if (b->kind != k)
+                return { b, Error_code::expected_type };
+            Raw const text = b.str();
+            return { ++b, text };
+        };
+    }
+
+    //  A token of kind k
+    inline auto is(std::int32_t k)
+    {
+        return [k](Token_iter b,Token_iter e) -> Token_result<Nothing>
+        {
+            if (b == e)
+                return { b, Error_code::unexpected_eof };
+            if (b->kind != k)
+                return { b, Error_code::expected_type };
+            return { ++b, Nothing {} };
+        };
+    }
+
+    //  A token with the given text. Prefer is for tokens with a kind of
+    //  their own, which does not compare the text.
+    inline auto lit(std::string_view text)
+    {
+        return [text](Token_iter b,Token_iter e) -> Token_result<Nothing>
+        {
+            if (b == e)
+                return { b, Error_code::unexpected_eof };
+            if (b.str() != text)
+                return { b, Error_code::expected_string };
+            return { ++b, Nothing {} };
+        };
+    }
+
+    //  A token of kind k, converted by the character parser p, which must
+    //  parse all of its text
+    template<class P>
+    auto value(std::int32_t k,P p)
+    {
+        static_assert(is_real_parser<P>(),"value requires a real parser");
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+        return [k,p](Token_iter b,Token_iter e) -> Token_result<Parsed_type<P>>
+        {
+            if (b == e)
+                return { b, Error_code::unexpected_eof };
+            if (b->kind != k)
+                return { b, Error_code::expected_type };
+            Raw const text = b.str();
+            auto res = p(text.begin(),text.end());
+            if (!res)
+                return { b, res.error() };
+            if (res.iter != text.end())
+                return { b, Error_code::expected_eof };
+            return { ++b, std::move(res.value()) };
+        };
+    }
+
+    //  The end of the tokens
+    inline auto end(Token_iter b,Token_iter e) -> Token_result<Nothing>
+    {
+        if (b != e)
+            return { b, Error_code::expected_eof };
+        return { b, Nothing {} };
+    }
+
+    //  ps in sequence. The result leaves out the Nothings of skipping
+    //  parsers: it is Nothing, the single value or a std::tuple.
+    template<class... Ps>
+    auto seq(Ps... ps)
+    {
+        using namespace boost::mp11;
+        using Vals = std::tuple<std::optional<details::token_value<Ps>>...>;
+        using Real = mp_copy_if_q<mp_iota_c<sizeof...(Ps)>,
+            mp_bind<mp_not,mp_bind<std::is_same,mp_bind<mp_at,mp_list<details::token_value<Ps>...>,_1>,Nothing>>>;
+        using Result = decltype(details::token_collect(std::declval<Vals&>(),Real {}));
+
+        return [tup = std::tuple(ps...)](Token_iter b,Token_iter e) -> Token_result<Result>
+        {
+            Vals vals;
+            Token_iter pos = b;
+            Token_iter fail = b;
+            Error_code ec = Error_code::no_error;
+            mp_for_each<mp_iota_c<sizeof...(Ps)>>([&](auto I)
+            {
+                if (ec != Error_code::no_error)
+                    return;
+                auto res = std::get<I>(tup)(pos,e);
+                if (!res)
+                {
+                    fail = res.iter;
+                    ec = res.error();
+                    return;
+                }
+                pos = res.iter;
+                std::get<I>(vals) = std::move(res.value());
+            });
+            if (ec != Error_code::no_error)
+                return { fail, ec };
+            return { pos, details::token_collect(vals,Real {}) };
+        };
+    }
+
+    //  The first of ps to match. The result is the common type of ps or a
+    //  std::variant of their types. If none match, the error is that of
+    //  the alternative getting furthest.
+    template<class... Ps>
+    auto choice(Ps... ps)
+    {
+        using namespace boost::mp11;
+        using Types = mp_unique<mp_list<details::token_value<Ps>...>>;
+        using Result = std::conditional_t<mp_size<Types>::value == 1,mp_front<Types>,mp_rename<Types,std::variant>>;
+
+        return [tup = std::tuple(ps...)](Token_iter b,Token_iter e) -> Token_result<Result>
+        {
+            std::optional<Token_result<Result>> found;
+            Token_iter fail = b;
+            Error_code ec = Error_code::unknown_error;
+            mp_for_each<mp_iota_c<sizeof...(Ps)>>([&](auto I)
+            {
+                if (found)
+                    return;
+                auto res = std::get<I>(tup)(b,e);
+                if (res)
+                    found.emplace(res.iter,Result { std::move(res.value()) });
+                else if (I == 0 || res.iter > fail)
+                {
+                    fail = res.iter;
+                    ec = res.error();
+                }
+            });
+            if (found)
+                return std::move(*found);
+            return { fail, ec };
+        };
+    }
+
+    //  Zero or more p separated by sep. A separator not followed by a p is
+    //  not consumed. The result is a std::vector, or Nothing for p giving
+    //  Nothing.
+    template<class P,class Sep>
+    auto repeat(P p,Sep sep)
+    {
+        using T = details::token_value<P>;
+        using Result = std::conditional_t<std::is_same_v<T,Nothing>,Nothing,std::vector<T>>;
+
+        return [p,sep](Token_iter b,Token_iter e) -> Token_result<Result>
+        {
+            Result result {};
+            Token_iter pos = b;
+            for (bool first = true;; first = false)
+            {
+                Token_iter next = pos;
+                if (!first)
+                {
+                    auto s = sep(pos,e);
+                    if (!s)
+                        break;
+                    next = s.iter;
+                }
+                auto res = p(next,e);
+                if (!res || res.iter == pos)
+                    break;
+                if constexpr (!std::is_same_v<T,Nothing>)
+                    result.push_back(std::move(res.value()));
+                pos = res.iter;
+            }
+            return { pos, std::move(result) };
+        };
+    }
+
+    template<class P>
+    auto repeat(P p)
+    {
+        return tok::repeat(std::move(p),[](Token_iter b,Token_iter) -> Token_result<Nothing>
+        {
+            return { b, Nothing {} };
+        });
+    }
+
+    //  p or nothing, as std::optional, or Nothing for p giving Nothing
+    template<class P>
+    auto opt(P p)
+    {
+        using T = details::token_value<P>;
+        using Result = std::conditional_t<std::is_same_v<T,Nothing>,Nothing,std::optional<T>>;
+
+        return [p](Token_iter b,Token_iter e) -> Token_result<Result>
+        {
+            auto res = p(b,e);
+            if (res)
+                return { res.iter, Result { std::move(res.value()) } };
+            return { b, Result {} };
+        };
+    }
+}   //  namespace qdpeg::tok
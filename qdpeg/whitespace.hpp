@@ -1,6 +1,7 @@
 #pragma once
 #include <qdpeg/cpp20.hpp>
 #include <qdpeg/qdbase.hpp>
+#include <qdpeg/literal_trie.hpp>
 #include <qdpeg/parse_char.hpp>
 #include <qdpeg/repeat.hpp>
 #include <qdpeg/strlit.hpp>
@@ -11,51 +12,90 @@
 namespace qdpeg
 {
     template<class P>
-    auto skip(P parser)
+    constexpr auto skip(P parser)
     {
         static_assert(is_parser<P>());
-        return [parser](Iter b,Iter e) mutable -> Skipper
+        static_assert(is_const_parser<P>(),"Parsers must be callable as const");
+        return [parser](Iter b,Iter e) -> Skipper
         {
             auto res = parser(b,e);
             return res;
         };
     }
 
-    inline auto lit(char ch)
+    namespace details
     {
-        return [ch](Iter b,Iter e) mutable -> Skipper
+        //  The literal parsers are named types so that choice can
+        //  recognise them, see literal_traits
+        struct Char_literal
         {
-            if (b == e)
-                return { b,Error_code::unexpected_eof};
-            char res {*b};
-            if (res != ch)
-                return { b,Error_code::unexpected_char };
-            return { ++b };
+            char ch;
+
+            QDPEG_CONSTEXPR20 auto operator()(Iter b,Iter e) const -> Skipper
+            {
+                if (b == e)
+                    return { b,Error_code::unexpected_eof};
+                char res {*b};
+                if (res != ch)
+                    return { b,Error_code::unexpected_char };
+                return { ++b };
+            }
         };
-    }
 
-    template<class T>
-    auto make_literal(T s) 
-    {
-        return [s = std::move(s)](Iter b,Iter e) mutable -> Skipper
+        template<class T>
+        struct Literal
         {
-            auto avail = e - b;
-            if (avail < static_cast<signed long>(s.size()))
-                return { b,Error_code::unexpected_eof };
+            T s;
+
+            constexpr auto operator()(Iter b,Iter e) const -> Skipper
+            {
+                auto avail = e - b;
+                if (avail < static_cast<signed long>(s.size()))
+                    return { b,Error_code::unexpected_eof };
 
-            auto new_b = b + cpp20::ssize(s);
-            if (s != make_raw(b,new_b))
-                return parse_status { b,Error_code::expected_string };
-            return { new_b };
+                auto new_b = b + cpp20::ssize(s);
+                if (s != make_raw(b,new_b))
+                    return parse_status { b,Error_code::expected_string };
+                return { new_b };
+            }
         };
+
+        template<>
+        struct literal_traits<Char_literal>
+        {
+            static constexpr bool is_literal = true;
+            static constexpr bool case_insensitive = false;
+            static std::string_view key(Char_literal const& p) { return { &p.ch, 1 }; }
+            static Nothing value(Char_literal const&) { return {}; }
+        };
+
+        template<class T>
+        struct literal_traits<Literal<T>>
+        {
+            static constexpr bool is_literal = std::is_convertible_v<T const&,std::string_view>;
+            static constexpr bool case_insensitive = std::is_same_v<T,ci_strlit>;
+            static std::string_view key(Literal<T> const& p) { return p.s; }
+            static Nothing value(Literal<T> const&) { return {}; }
+        };
+    }   //  namespace details
+
+    constexpr auto lit(char ch)
+    {
+        return details::Char_literal { ch };
+    }
+
+    template<class T>
+    constexpr auto make_literal(T s) 
+    {
+        return details::Literal<T> { std::move(s) };
     }
 
-    inline auto lit(str_lit s)
+    constexpr auto lit(str_lit s)
     {
         return make_literal(s);
     }
 
-    inline auto ci_lit(ci_strlit s)
+    constexpr auto ci_lit(ci_strlit s)
     {
         return make_literal(s);
     }
@@ -74,7 +114,7 @@ namespace qdpeg
 
     inline auto spaced_lit(char ch)
     {
-        return [ch](Iter b,Iter e) mutable -> Skipper
+        return [ch](Iter b,Iter e) -> Skipper
         {
             b  = textspace(b,e);
             if (std::isspace(ch))
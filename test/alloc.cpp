@@ -0,0 +1,183 @@
+//  Counts the calls of the global operator new during parsing and the
+//  bytes they allocate. Fails if a parser the README lists as allocation
+//  free allocates, and reports both per parse and per input byte for
+//  parsers building containers.
+#include <qdpeg/qdpeg.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    std::size_t allocations = 0;
+    std::size_t allocated_bytes = 0;
+}
+
+//  GCC pairs the inlined std::free with the replaced operator new and
+//  warns of a mismatch, but both sides use malloc and free
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t n)
+{
+    ++allocations;
+    allocated_bytes += n;
+    if (void* p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc {};
+}
+
+void* operator new[](std::size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p,std::size_t) noexcept { operator delete(p); }
+void operator delete[](void* p,std::size_t) noexcept { operator delete(p); }
+
+using namespace qdpeg;
+
+namespace
+{
+    int failures = 0;
+
+    struct Usage
+    {
+        std::size_t allocations;
+        std::size_t bytes;
+    };
+
+    //  The allocations of one parse of text with p, including destroying
+    //  the result. Fails if p does not parse all of text.
+    template<class P>
+    Usage allocations_of(char const* name,P const& p,std::string_view text)
+    {
+        std::size_t const before = allocations;
+        std::size_t const before_bytes = allocated_bytes;
+        {
+            auto res = p(text.begin(),text.end());
+            if (!res || res.iter != text.end())
+            {
+                std::printf("FAIL %s: does not parse \"%.*s\"\n",name,int(text.size()),text.data());
+                ++failures;
+            }
+        }
+        return { allocations - before, allocated_bytes - before_bytes };
+    }
+
+    //  A parser the README lists as allocation free. The first parse may
+    //  initialise statics, so the second is counted.
+    template<class P>
+    void expect_free(char const* name,P const& p,std::string_view text)
+    {
+        allocations_of(name,p,text);
+        Usage const n = allocations_of(name,p,text);
+        if (n.allocations != 0)
+        {
+            std::printf("FAIL %s: %zu allocations of %zu bytes\n",name,n.allocations,n.bytes);
+            ++failures;
+        }
+    }
+
+    template<class P>
+    void report(char const* name,P const& p,std::string_view text)
+    {
+        Usage const n = allocations_of(name,p,text);
+        double const input = double(text.size());
+        std::printf("%-24s input %6zu bytes: %4zu allocations of %7zu bytes, %.4f allocations and %.2f bytes per input byte\n",
+            name,text.size(),n.allocations,n.bytes,double(n.allocations) / input,double(n.bytes) / input);
+    }
+
+    struct Point { double x; double y; };
+    enum class Colour { red, green, blue };
+    enum class Method { get, get_all, post, put, del };
+}
+
+int main()
+{
+    //  Character parsers and classes
+    expect_free("digit",digit(),"7");
+    expect_free("alpha",alpha(),"q");
+    expect_free("char_from",char_from<'q','e','d'>,"e");
+    expect_free("char_classes::alnum",char_classes::alnum,"Z");
+
+    //  Numbers
+    expect_free("int_parser<int>",int_parser<int>,"-1234567");
+    expect_free("int_parser<unsigned,16>",int_parser<unsigned,16>,"beef");
+    expect_free("int_parser, required sign",int_parser<int,10,sign_policy::required>,"+42");
+    expect_free("real_parser<double>",real_parser<double>,"-1.25e-3");
+    expect_free("real_parser<double> inf",real_parser<double>,"-inf");
+    expect_free("decimal_parser",decimal_parser<std::int64_t,4>,"-0.0125");
+    expect_free("parse_bool",parse_bool,"true");
+
+    //  Dates, times and addresses
+    expect_free("date_parser",date_parser,"2024-02-29");
+    expect_free("timestamp_parser",timestamp_parser,"2024-02-29T12:34:56.789+01:00");
+    expect_free("ipv4_parser",ipv4_parser,"192.168.0.1");
+    expect_free("ipv6_parser",ipv6_parser,"2001:db8::ff00:42:8329");
+
+    //  Binary
+    expect_free("le<uint32_t>",le<std::uint32_t>,std::string_view("\x01\x02\x03\x04",4));
+    expect_free("varint<int>",varint<int>,"\x96\x01");
+    expect_free("zigzag<int>",zigzag<int>,"\x03");
+    expect_free("bytes",bytes(le<std::uint8_t>),"\x03" "abc");
+
+    //  Literals, symbols and scanners
+    static Symbol<Colour> const colours { { "red", Colour::red }, { "green", Colour::green }, { "blue", Colour::blue } };
+    expect_free("lit(char)",lit('x'),"x");
+    expect_free("lit(string)",lit("abc"),"abc");
+    expect_free("ci_lit",ci_lit("abc"),"AbC");
+    expect_free("spaced_lit",spaced_lit(','),"  ,  ");
+    expect_free("Symbol",colours,"green");
+    expect_free("scan_until",seq(scan_until('"'),lit('"')),"hello \"");
+    expect_free("span_of",span_of(char_classes::digit,1),"12345");
+    static auto const ident = lexeme(re::seq(re::chars(char_classes::alpha),re::star(re::chars(char_classes::alnum))));
+    expect_free("lexeme",ident,"abc123");
+
+    //  Combinators over allocation free parsers
+    static auto const method = choice(
+        as(lit("GET"),Method::get),
+        as(lit("GETALL"),Method::get_all),
+        as(ci_lit("post"),Method::post),
+        as(lit("PUT"),Method::put),
+        as(lit("DELETE"),Method::del));
+    expect_free("choice of literals (trie)",method,"post");
+    expect_free("choice",choice(int_parser<int>,as(lit("none"),0)),"none");
+    expect_free("raw",raw(seq(alpha(),span_of(char_classes::alnum))),"a12");
+    expect_free("as",as(int_parser<int>,[](int v) { return v * 2; }),"21");
+    expect_free("check",check(int_parser<int>,[](int v) { return v > 0; }),"21");
+    expect_free("opt",seq(opt(lit('-')),int_parser<int>),"-5");
+    expect_free("and_p",seq(and_p(digit()),int_parser<int>),"5");
+    expect_free("not_p",seq(not_p(lit('-')),int_parser<int>),"5");
+
+    //  Composed grammars
+    auto setting = seq_ws(textspace,span_of(char_classes::ident,1),lit('='),int_parser<int>,lit(';'));
+    expect_free("seq_ws key=value",setting,"answer = 42;");
+    auto point = seq<Point>(lit('('),real_parser<double>,spaced_lit(','),real_parser<double>,lit(')'));
+    expect_free("seq point",point,"(1.5, -2)");
+    auto stamp = seq(date_parser,lit(' '),ipv4_parser,lit(' '),method);
+    expect_free("seq log line",stamp,"2024-01-01 10.0.0.1 GET");
+
+    //  Parsers building containers
+    std::string csv;
+    for (int i = 0; i < 1000; ++i)
+        csv += std::to_string(i * 7919) + (i < 999 ? "," : "");
+    report("repeat int_parser",repeat(int_parser<int>,lit(',')),csv);
+    std::string words;
+    for (int i = 0; i < 1000; ++i)
+        words += "word" + std::to_string(i) + (i < 999 ? " " : "");
+    report("repeat of strings",repeat(repeat<std::string>(alnum(),at_least(1)),lit(' ')),words);
+    report("seq of the same type",seq(int_parser<int>,lit(','),int_parser<int>),"1,2");
+    report("repeat_into",repeat_into(int_parser<int>,[](int) {},lit(',')),csv);
+
+    if (failures > 0)
+    {
+        std::printf("%d failures\n",failures);
+        return 1;
+    }
+    std::printf("alloc: all allocation free parsers passed\n");
+    return 0;
+}
@@ -0,0 +1,77 @@
+//  adaptive_choice against choice on inputs where one alternative is far
+//  more frequent than the others, and on evenly spread inputs.
+#include <qdpeg/qdpeg.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace qdpeg;
+
+template<class P>
+long long time_ms(P const& p,std::vector<std::string> const& input,long& check)
+{
+    auto const t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < 10; ++rep)
+    {
+        for (auto const& line: input)
+        {
+            auto res = p(line.data(),line.data() + line.size());
+            check += res ? res.value() : 0;
+        }
+    }
+    auto const t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+}
+
+//  Numbers ending in one of the letters 'a' to 'e'. weights[i] is the
+//  percentage of letter i.
+std::vector<std::string> make_input(std::vector<int> const& weights)
+{
+    std::mt19937 rng(1);
+    std::discrete_distribution<int> letter(weights.begin(),weights.end());
+    std::vector<std::string> input;
+    for (int i = 0; i < 200000; ++i)
+        input.push_back(std::to_string(rng() % 100000) + char('a' + letter(rng)));
+    return input;
+}
+
+int main()
+{
+    auto alt = [](char ch) { return seq(int_parser<int>,lit(ch)); };
+    auto fixed = choice(alt('a'),alt('b'),alt('c'),alt('d'),alt('e'));
+    auto adaptive = adaptive_choice(alt('a'),alt('b'),alt('c'),alt('d'),alt('e'));
+
+    struct Case
+    {
+        char const* name;
+        std::vector<int> weights;
+    };
+    Case const cases[] = {
+        { "90% last alternative", { 3, 2, 3, 2, 90 } },
+        { "90% first alternative", { 90, 3, 2, 3, 2 } },
+        { "evenly spread", { 20, 20, 20, 20, 20 } },
+    };
+
+    long check = 0;
+    for (auto const& c: cases)
+    {
+        auto const input = make_input(c.weights);
+
+        //  The best of five rounds, alternating the two
+        long long a = -1;
+        long long b = -1;
+        for (int round = 0; round < 5; ++round)
+        {
+            auto const ta = time_ms(fixed,input,check);
+            auto const tb = time_ms(adaptive,input,check);
+            a = a < 0 ? ta : std::min(a,ta);
+            b = b < 0 ? tb : std::min(b,tb);
+        }
+        std::printf("%-22s %zu inputs x 10: choice %lld ms, adaptive_choice %lld ms\n",
+            c.name,input.size(),a,b);
+    }
+    return check == 0;
+}
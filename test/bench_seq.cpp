@@ -0,0 +1,108 @@
+//  A sequence parsing a record of ten fields: the results constructed in
+//  place in the returned Parse_result, against the former construction
+//  from a tuple of Parse_results.
+#include <qdpeg/qdpeg.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace qdpeg;
+
+struct Record
+{
+    int         id;
+    std::string name;
+    int         year;
+    std::string city;
+    int         count;
+    std::string street;
+    int         zip;
+    std::string country;
+    int         level;
+    std::string note;
+};
+
+//  The former path: each field is parsed into a Parse_result held in a
+//  tuple, and the record is brace constructed from it when all succeeded
+template<class Ret,class Sep,class PTup,std::size_t... I>
+auto parse_via_tuple(Iter b,Iter e,Sep const& sep,PTup const& ptup,std::index_sequence<I...>)
+    -> Parse_result<Ret>
+{
+    std::tuple<Parsed_return<std::tuple_element_t<I,PTup>>...> rs;
+    bool ok = true;
+    auto field = [&](auto& r,auto const& p,bool first)
+    {
+        if (!ok) return;
+        if (!first)
+        {
+            auto s = sep(b,e);
+            if (!s) { ok = false; return; }
+            b = s.iter;
+        }
+        r = p(b,e);
+        ok = bool(r);
+        b = r.iter;
+    };
+    (field(std::get<I>(rs),std::get<I>(ptup),I == 0),...);
+    if (!ok) return { b, Error_code::unknown_error };
+    return { b, Ret { std::move(std::get<I>(rs).value())... } };
+}
+
+template<class Ret,class Sep,class... Ps>
+auto tuple_seq(Sep sep,Ps... ps)
+{
+    return [sep,ptup = std::tuple { ps... }](Iter b,Iter e) -> Parse_result<Ret>
+    {
+        return parse_via_tuple<Ret>(b,e,sep,ptup,std::index_sequence_for<Ps...> {});
+    };
+}
+
+template<class P>
+long long time_ms(P const& p,std::vector<std::string> const& input,long& check)
+{
+    auto const t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < 10; ++rep)
+    {
+        for (auto const& line: input)
+        {
+            auto res = p(line.data(),line.data() + line.size());
+            check += res ? res.value().zip : 0;
+        }
+    }
+    auto const t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+}
+
+int main()
+{
+    auto num = int_parser<int>;
+    auto word = repeat<std::string>(alpha(),at_least(1));
+    auto in_place = seq_ws<Record>(lit(','),num,word,num,word,num,word,num,word,num,word);
+    auto via_tuple = tuple_seq<Record>(lit(','),num,word,num,word,num,word,num,word,num,word);
+
+    std::vector<std::string> input;
+    for (int i = 0; i < 100000; ++i)
+    {
+        input.push_back(std::to_string(i) + ",Someone,1970,Copenhagen," + std::to_string(i % 97)
+            + ",Longstreetname," + std::to_string(1000 + i % 9000) + ",Denmark,3,Nothingtoreport");
+    }
+
+    //  The best of five rounds, alternating the two
+    long check = 0;
+    long long a = -1;
+    long long b = -1;
+    for (int round = 0; round < 5; ++round)
+    {
+        auto const ta = time_ms(in_place,input,check);
+        auto const tb = time_ms(via_tuple,input,check);
+        a = a < 0 ? ta : std::min(a,ta);
+        b = b < 0 ? tb : std::min(b,tb);
+    }
+    std::printf("seq of 10 fields, %zu records x 10: in place %lld ms, tuple of results %lld ms\n",
+        input.size(),a,b);
+    return check == 0;
+}
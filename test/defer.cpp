@@ -0,0 +1,65 @@
+//  Deferred actions: run once, only for the alternative kept, also after a
+//  lookahead and after the parser that made them is gone.
+#include <qdpeg/qdpeg.hpp>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+using namespace qdpeg;
+
+namespace
+{
+    int failures = 0;
+    int calls = 0;
+
+    void expect(bool ok,char const* name)
+    {
+        if (!ok)
+        {
+            std::printf("FAIL %s\n",name);
+            ++failures;
+        }
+    }
+
+    template<class P>
+    auto parse(P const& p,std::string_view text)
+    {
+        return p(text.begin(),text.end());
+    }
+
+    //  The grammar is a temporary of the caller
+    auto doubled_before_b()
+    {
+        return force(defer(seq(int_parser<int>,and_p(lit('b'))),[](int v) { ++calls; return v * 2; }));
+    }
+}
+
+int main()
+{
+    calls = 0;
+    auto ahead = parse(doubled_before_b(),"12b");
+    expect(ahead && ahead.value() == 24 && calls == 1,"lookahead after the deferred parser");
+
+    auto word = defer(raw(repeat(alpha(),at_least(1))),[](Raw t) { ++calls; return std::string(t); });
+    calls = 0;
+    auto stmt = parse(force(choice(seq(word,lit('!')),seq(word,lit('?')))),"go?");
+    expect(stmt && stmt.value() == "go" && calls == 1,"action of the backtracked alternative not run");
+
+    auto late = [] { return parse(defer(int_parser<int>,[k = 5](int v) { return v + k; }),"3"); }();
+    expect(late && resolve(std::move(late.value())) == 8,"resolved after the parser is destroyed");
+
+    auto boxed = defer(as(int_parser<int>,[](int v) { return std::make_unique<int>(v); }),
+        [](std::unique_ptr<int> p) { return *p + 1; });
+    auto list = parse(force(seq(boxed,lit(','),boxed)),"1,2");
+    expect(list && list.value().size() == 2 && list.value()[1] == 3,"move-only values in a vector");
+
+    if (failures > 0)
+    {
+        std::printf("%d failures\n",failures);
+        return 1;
+    }
+    std::printf("defer: all passed\n");
+    return 0;
+}
@@ -0,0 +1,93 @@
+//  Printing the values parsers produce, and parsing the printed text
+//  back to the same values.
+#include <qdpeg/qdpeg.hpp>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+using namespace qdpeg;
+
+namespace
+{
+    int failures = 0;
+
+    //  Parse text with p, print the value with pr and parse the printed
+    //  text again. Both texts must give the same value.
+    template<class P,class Pr>
+    void round_trip(char const* name,P const& p,Pr const& pr,std::string_view text)
+    {
+        auto first = p(text.begin(),text.end());
+        if (!first || first.iter != text.end())
+        {
+            std::printf("FAIL %s: does not parse \"%.*s\"\n",name,int(text.size()),text.data());
+            ++failures;
+            return;
+        }
+        char buf[256];
+        auto res = format(buf,buf + sizeof buf,pr,first.value());
+        if (res.ec != std::errc {})
+        {
+            std::printf("FAIL %s: can not print the value of \"%.*s\"\n",name,int(text.size()),text.data());
+            ++failures;
+            return;
+        }
+        std::string_view printed(buf,res.ptr - buf);
+        auto second = p(printed.begin(),printed.end());
+        if (!second || second.iter != printed.end() || !(second.value() == first.value()))
+        {
+            std::printf("FAIL %s: \"%.*s\" printed as \"%.*s\"\n",name,
+                int(text.size()),text.data(),int(printed.size()),printed.data());
+            ++failures;
+        }
+    }
+
+    enum class Colour { red, green, blue };
+}
+
+int main()
+{
+    //  seq of values of one type gives a std::vector
+    auto point = seq(lit('('),int_parser<int>,lit(','),int_parser<int>,lit(')'));
+    auto point_pr = fmt::seq(fmt::lit('('),fmt::integer<int>,fmt::lit(','),fmt::integer<int>,fmt::lit(')'));
+    round_trip("seq of one type",point,point_pr,"(3,-4)");
+
+    auto pair = seq(int_parser<int>,lit(':'),real_parser<double>);
+    auto pair_pr = fmt::seq(fmt::integer<int>,fmt::lit(':'),fmt::real<double>);
+    round_trip("seq to a tuple",pair,pair_pr,"7:0.1");
+
+    auto number = choice(seq(lit('#'),int_parser<int>),real_parser<double>);
+    auto number_pr = fmt::choice(fmt::seq(fmt::lit('#'),fmt::integer<int>),fmt::real<double>);
+    round_trip("choice, first",number,number_pr,"#12");
+    round_trip("choice, second",number,number_pr,"2.5e-3");
+
+    Symbol<Colour> const colours { { "red", Colour::red }, { "green", Colour::green }, { "blue", Colour::blue } };
+    auto tagged = seq(opt(seq(lit('-'),colours)),lit(';'));
+    auto tagged_pr = fmt::seq(fmt::opt(fmt::seq(fmt::lit('-'),fmt::symbol(colours))),fmt::lit(';'));
+    round_trip("opt and symbol, present",tagged,tagged_pr,"-green;");
+    round_trip("opt and symbol, absent",tagged,tagged_pr,";");
+
+    auto list = repeat(int_parser<unsigned,16>,lit(','));
+    auto list_pr = fmt::repeat(fmt::integer<unsigned,16>,fmt::lit(','));
+    round_trip("repeat",list,list_pr,"ff,0,10");
+
+    //  A container must have a value for each printer
+    char buf[64];
+    auto short_res = format(buf,buf + sizeof buf,point_pr,std::vector<int> { 1 });
+    if (short_res.ec != std::errc::invalid_argument)
+    {
+        std::printf("FAIL seq of one type: a vector of the wrong size is printed\n");
+        ++failures;
+    }
+
+    if (failures > 0)
+    {
+        std::printf("%d failures\n",failures);
+        return 1;
+    }
+    std::printf("format: all passed\n");
+    return 0;
+}
@@ -0,0 +1,113 @@
+//  Parses into a node type that can only be moved, through each
+//  combinator passing values on.
+#include <qdpeg/qdpeg.hpp>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+using namespace qdpeg;
+
+namespace
+{
+    int failures = 0;
+
+    void expect(bool ok,char const* name)
+    {
+        if (!ok)
+        {
+            std::printf("FAIL %s\n",name);
+            ++failures;
+        }
+    }
+
+    struct Node
+    {
+        explicit Node(int v): value(v) {}
+        Node(Node const&) = delete;
+        Node& operator=(Node const&) = delete;
+        Node(Node&&) = default;
+        Node& operator=(Node&&) = default;
+
+        int                     value;
+        std::unique_ptr<Node>   next;
+    };
+    using Ptr = std::unique_ptr<Node>;
+
+    static_assert(!std::is_copy_constructible_v<Parse_result<Ptr>>);
+    static_assert(!std::is_copy_assignable_v<Parse_result<Ptr>>);
+    static_assert(std::is_copy_constructible_v<Parse_result<int>>);
+
+    auto const node = as(int_parser<int>,[](int v) { return std::make_unique<Node>(v); });
+
+    //  A comma separated list of numbers as a linked list of nodes
+    struct List
+    {
+        Parse_result<Ptr> operator()(Iter b,Iter e) const
+        {
+            auto link = as(seq(node,opt(seq(lit(','),*this))),[](std::tuple<Ptr,std::optional<Ptr>> t)
+            {
+                auto& [head,rest] = t;
+                if (rest)
+                    head->next = std::move(*rest);
+                return std::move(head);
+            });
+            return link(b,e);
+        }
+    };
+
+    template<class P>
+    auto parse(P const& p,std::string_view text)
+    {
+        return p(text.begin(),text.end());
+    }
+}
+
+int main()
+{
+    auto list = parse(List {},"1,2,3");
+    expect(list && list.value()->value == 1 && list.value()->next->next->value == 3,"as, opt and seq to a tuple");
+
+    auto same = parse(seq(node,lit(';'),node),"4;5");
+    expect(same && same.value().size() == 2 && same.value()[1]->value == 5,"seq of the same type");
+
+    auto tup = parse(seq(node,lit(' '),int_parser<int>),"6 7");
+    expect(tup && std::get<0>(tup.value())->value == 6 && std::get<1>(tup.value()) == 7,"seq to a tuple");
+
+    auto nil = as(lit('x'),[](Nothing) { return Ptr(); });
+    auto alt = parse(choice(nil,List {}),"8,9");
+    expect(alt && alt.value()->next->value == 9,"choice");
+    auto first = parse(choice(nil,List {}),"x");
+    expect(first && !first.value(),"choice, first alternative");
+
+    auto maybe = parse(seq(lit('['),opt(node),lit(']')),"[]");
+    expect(maybe && !maybe.value(),"opt, absent");
+
+    auto checked = check(List {},[](Ptr const& p) { return p->value == 1; });
+    expect(bool(parse(checked,"1,2")),"check, passing");
+    expect(!parse(checked,"2,1"),"check, failing");
+
+    auto ahead = parse(seq(and_p(lit('1')),List {}),"1,2");
+    expect(ahead && ahead.value()->next->value == 2,"and_p");
+
+    auto made = parse(emit_with([] { return std::make_unique<Node>(10); }),"");
+    expect(made && made.value()->value == 10,"emit_with");
+
+    auto by_value = parse(as(int_parser<int>,[](int v) { return Node(v); }),"11");
+    expect(by_value && by_value.value().value == 11,"as, node by value");
+
+    auto moved = std::move(list);
+    moved = parse(List {},"12");
+    expect(moved && moved.value()->value == 12,"Parse_result move assignment");
+
+    if (failures > 0)
+    {
+        std::printf("%d failures\n",failures);
+        return 1;
+    }
+    std::printf("move_only: all passed\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+//  Parses with one const grammar from several threads at once and checks
+//  every result. Build with make tsan to run it under ThreadSanitizer.
+#include <qdpeg/qdpeg.hpp>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
+
+using namespace qdpeg;
+
+namespace
+{
+    enum class Method { get, get_all, post, put, del };
+    enum class Colour { red, green, blue };
+
+    using Value = std::variant<int,Colour,Method>;
+
+    //  The grammar shared by all threads: a compiled choice of literals, a
+    //  Symbol, and an adaptive_choice reordering its alternatives while
+    //  the threads parse
+    Symbol<Colour> const colours { { "red", Colour::red }, { "green", Colour::green }, { "blue", Colour::blue } };
+
+    auto const methods = choice(
+        as(lit("GETALL"),Method::get_all),
+        as(lit("GET"),Method::get),
+        as(lit("POST"),Method::post),
+        as(lit("PUT"),Method::put),
+        as(lit("DELETE"),Method::del));
+
+    auto const value = adaptive_choice<Value>(
+        seq(lit('#'),int_parser<int>),
+        seq(lit('@'),colours),
+        seq(lit('!'),methods));
+
+    auto const line = seq_ws(textspace,value,lit(';'));
+
+    struct Sample
+    {
+        std::string text;
+        Value expected;
+    };
+
+    //  Each thread starts at a different sample and so sees another mix,
+    //  making the adaptive_choice reorder concurrently
+    std::vector<Sample> samples()
+    {
+        std::vector<Sample> v;
+        for (int i = 0; i < 64; ++i)
+            v.push_back({ "#" + std::to_string(i * 37) + " ;", Value { i * 37 } });
+        char const* const colour_names[] = { "red", "green", "blue" };
+        for (int i = 0; i < 3; ++i)
+            v.push_back({ std::string("@") + colour_names[i] + ";", Value { Colour(i) } });
+        char const* const method_names[] = { "GET", "GETALL", "POST", "PUT", "DELETE" };
+        for (int i = 0; i < 5; ++i)
+            v.push_back({ std::string("!") + method_names[i] + " ;", Value { Method(i) } });
+        return v;
+    }
+}
+
+int main()
+{
+    unsigned const n_threads = std::max(4u,std::thread::hardware_concurrency());
+    int const rounds = 20000;
+    auto const work = samples();
+    std::atomic<long> failures { 0 };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < n_threads; ++t)
+    {
+        threads.emplace_back([&work,&failures,t]
+        {
+            long bad = 0;
+            for (int r = 0; r < rounds; ++r)
+            {
+                //  Skewed per thread: every other parse is the thread's own sample
+                std::size_t const i = r % 2 ? (t * 7) % work.size() : (t + r) % work.size();
+                std::string_view text = work[i].text;
+                auto res = line(text.begin(),text.end());
+                if (!res || res.iter != text.end() || res.value() != work[i].expected)
+                    ++bad;
+            }
+            failures += bad;
+        });
+    }
+    for (auto& th: threads)
+        th.join();
+
+    if (failures > 0)
+    {
+        std::printf("FAIL threads: %ld wrong results\n",failures.load());
+        return 1;
+    }
+    std::printf("threads: %u threads, %d parses each, all correct\n",n_threads,rounds);
+    return 0;
+}